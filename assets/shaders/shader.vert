@@ -1,23 +1,48 @@
 #version 450
 
-// Vertex input attributes (must match Vertex struct in mesh.h)
-layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec3 inNormal;
-layout(location = 2) in vec2 inTexCoord;
+// Vertex input attributes (must match the packed Vertex struct in mesh.h)
+// inPosition: bits 0-4 x, 5-9 y, 10-14 z (chunk-local), bits 15-17 face
+// inSurface:  bits 0-4 u, 5-9 v, bits 10-17 voxel type
+layout(location = 0) in uint inPosition;
+layout(location = 1) in uint inSurface;
 
 // Uniform buffer for MVP matrix
 layout(binding = 0) uniform UniformBufferObject {
     mat4 mvp;
 } ubo;
 
+// Per-draw chunk data (must match ChunkDrawData in indirect_draw_buffer.h).
+// Each draw's firstInstance is its index here.
+struct ChunkDrawData {
+    vec4 origin;
+};
+
+layout(std430, binding = 1) readonly buffer ChunkDrawDataBuffer {
+    ChunkDrawData draws[];
+} chunkDraws;
+
 // Output to fragment shader
 layout(location = 0) out vec3 fragNormal;
 layout(location = 1) out vec2 fragTexCoord;
 layout(location = 2) out float fragWorldY;
 
+// Normal for each face index, in ChunkFace order (chunk.h)
+const vec3 FACE_NORMALS[6] = vec3[](
+    vec3(-1.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0),
+    vec3(0.0, -1.0, 0.0), vec3(0.0, 1.0, 0.0),
+    vec3(0.0, 0.0, -1.0), vec3(0.0, 0.0, 1.0)
+);
+
 void main() {
-    gl_Position = ubo.mvp * vec4(inPosition, 1.0);
-    fragNormal = inNormal;
-    fragTexCoord = inTexCoord;
-    fragWorldY = inPosition.y;
-}
\ No newline at end of file
+    vec3 localPosition = vec3(float(bitfieldExtract(inPosition, 0, 5)),
+                              float(bitfieldExtract(inPosition, 5, 5)),
+                              float(bitfieldExtract(inPosition, 10, 5)));
+    uint face = bitfieldExtract(inPosition, 15, 3);
+    vec3 worldPosition = chunkDraws.draws[gl_InstanceIndex].origin.xyz + localPosition;
+
+    gl_Position = ubo.mvp * vec4(worldPosition, 1.0);
+    fragNormal = FACE_NORMALS[face];
+    fragTexCoord = vec2(float(bitfieldExtract(inSurface, 0, 5)),
+                        float(bitfieldExtract(inSurface, 5, 5)));
+    fragWorldY = worldPosition.y;
+}
@@ -0,0 +1,154 @@
+// Chunk map microbenchmark: FlatHashMap keyed by packed ChunkKeys against
+// the std::unordered_map keyed by coordinate tuples that ChunkManager used
+// before. Times insert, lookup (hits and misses) and erase over streaming
+// windows of 4k to 50k chunks and prints nanoseconds per operation.
+//
+// Build with -DVOXEL_BUILD_BENCHMARKS=ON and run chunk_map_bench.
+
+#include "utils/flat_hash_map.h"
+#include "world/chunk_key.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+// The tuple hash the old chunk map used (formerly src/utils/tuple_hash.h)
+struct TupleHash {
+    std::size_t operator()(const std::tuple<int, int, int>& t) const {
+        auto h1 = std::hash<int>{}(std::get<0>(t));
+        auto h2 = std::hash<int>{}(std::get<1>(t));
+        auto h3 = std::hash<int>{}(std::get<2>(t));
+        return h1 ^ (h2 << 1) ^ (h3 << 2);
+    }
+};
+
+// Stand-in for ChunkManager's map value
+struct BenchEntry {
+    void* chunk;
+    uint32_t index;
+};
+
+struct Coord {
+    int x, y, z;
+};
+
+static const int REPEATS = 5;
+
+// Streaming window around a camera away from the origin: a square of
+// columns, `height` chunks tall, with coordinates on both sides of zero
+static std::vector<Coord> makeWindow(int chunkCount, int height) {
+    int side = 1;
+    while (side * side * height < chunkCount) {
+        ++side;
+    }
+    std::vector<Coord> coords;
+    coords.reserve(chunkCount);
+    for (int x = 0; x < side && static_cast<int>(coords.size()) < chunkCount; ++x) {
+        for (int z = 0; z < side && static_cast<int>(coords.size()) < chunkCount; ++z) {
+            for (int y = 0; y < height && static_cast<int>(coords.size()) < chunkCount; ++y) {
+                coords.push_back({x - side / 2 + 37, y - height / 2, z - side / 2 - 91});
+            }
+        }
+    }
+    return coords;
+}
+
+// Best of REPEATS runs of `run`, in nanoseconds per operation
+static double timeBest(size_t operations, const std::function<void()>& setup, const std::function<void()>& run) {
+    double best = 0.0;
+    for (int i = 0; i < REPEATS; ++i) {
+        setup();
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        const double perOp = elapsed.count() / static_cast<double>(operations);
+        if (i == 0 || perOp < best) {
+            best = perOp;
+        }
+    }
+    return best;
+}
+
+struct MapTimes {
+    double insert, lookup, erase;
+};
+
+static MapTimes benchTupleMap(const std::vector<Coord>& coords, uint64_t& sink) {
+    typedef std::unordered_map<std::tuple<int, int, int>, BenchEntry, TupleHash> TupleMap;
+    TupleMap map;
+    auto fill = [&]() {
+        map.clear();
+        for (size_t i = 0; i < coords.size(); ++i) {
+            map[std::make_tuple(coords[i].x, coords[i].y, coords[i].z)] = BenchEntry{nullptr, static_cast<uint32_t>(i)};
+        }
+    };
+
+    MapTimes times;
+    times.insert = timeBest(coords.size(), [&]() { map = TupleMap(); }, fill);
+
+    // Every resident chunk plus its +Y neighbour (a miss at the top layer)
+    times.lookup = timeBest(coords.size() * 2, fill, [&]() {
+        for (const Coord& c : coords) {
+            auto hit = map.find(std::make_tuple(c.x, c.y, c.z));
+            auto above = map.find(std::make_tuple(c.x, c.y + 1, c.z));
+            sink += hit->second.index + (above != map.end() ? 1 : 0);
+        }
+    });
+
+    times.erase = timeBest(coords.size(), fill, [&]() {
+        for (const Coord& c : coords) {
+            sink += map.erase(std::make_tuple(c.x, c.y, c.z));
+        }
+    });
+    return times;
+}
+
+static MapTimes benchFlatMap(const std::vector<Coord>& coords, uint64_t& sink) {
+    FlatHashMap<BenchEntry> map;
+    auto fill = [&]() {
+        map.clear();
+        for (size_t i = 0; i < coords.size(); ++i) {
+            map[ChunkKeys::pack(coords[i].x, coords[i].y, coords[i].z)] = BenchEntry{nullptr, static_cast<uint32_t>(i)};
+        }
+    };
+
+    MapTimes times;
+    times.insert = timeBest(coords.size(), [&]() { map = FlatHashMap<BenchEntry>(); }, fill);
+
+    times.lookup = timeBest(coords.size() * 2, fill, [&]() {
+        for (const Coord& c : coords) {
+            const BenchEntry* hit = map.find(ChunkKeys::pack(c.x, c.y, c.z));
+            const BenchEntry* above = map.find(ChunkKeys::pack(c.x, c.y + 1, c.z));
+            sink += hit->index + (above ? 1 : 0);
+        }
+    });
+
+    times.erase = timeBest(coords.size(), fill, [&]() {
+        for (const Coord& c : coords) {
+            sink += map.erase(ChunkKeys::pack(c.x, c.y, c.z));
+        }
+    });
+    return times;
+}
+
+int main() {
+    const int chunkCounts[] = {4096, 12000, 25000, 50000};
+    const int windowHeight = 16;
+    uint64_t sink = 0;
+
+    std::printf("%8s  %-24s %10s %10s %10s\n", "chunks", "map", "insert", "lookup", "erase");
+    for (int chunkCount : chunkCounts) {
+        const std::vector<Coord> coords = makeWindow(chunkCount, windowHeight);
+        const MapTimes tuple = benchTupleMap(coords, sink);
+        const MapTimes flat = benchFlatMap(coords, sink);
+        std::printf("%8d  %-24s %10.1f %10.1f %10.1f\n", chunkCount, "unordered_map<tuple>",
+                    tuple.insert, tuple.lookup, tuple.erase);
+        std::printf("%8d  %-24s %10.1f %10.1f %10.1f\n", chunkCount, "FlatHashMap<ChunkKey>",
+                    flat.insert, flat.lookup, flat.erase);
+    }
+    std::printf("(ns/op, best of %d runs; checksum %llu)\n", REPEATS, static_cast<unsigned long long>(sink));
+    return 0;
+}
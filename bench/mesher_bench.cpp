@@ -0,0 +1,215 @@
+// Mesher microbenchmark: quads per second of the binary mesher with
+// templated per-direction quad emission (emitQuad<Face>) against the same
+// mesher emitting through addQuad, which branches on the direction at run
+// time and appends with push_back. The reference greedy mesher is timed as
+// an extra column for context. Fixtures, one dense and two sparse:
+//   checkerboard  every other voxel solid, the worst case for quad count
+//   terrain       generated surface chunks meshed against their neighbours
+//   random        5% of voxels solid, scattered; half with neighbour layers
+// Both binary emission paths must produce exactly the same quads as the
+// reference mesher; every fixture chunk is checked before timing, and the
+// bench exits with a non-zero status on any mismatch.
+//
+// Build with -DVOXEL_BUILD_BENCHMARKS=ON and run mesher_bench.
+
+#include "world/chunk.h"
+#include "world/mesh_generator.h"
+#include "world/terrain_config.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Each measurement repeats the fixture until at least this much time has passed
+static const double MIN_SECONDS = 0.5;
+
+struct MeshFixture {
+    std::vector<PaletteStorage> voxels;
+    std::vector<ChunkBorders> borders;
+    std::vector<bool> hasBorders;
+
+    void add(const PaletteStorage& storage, const ChunkBorders* chunkBorders) {
+        voxels.push_back(storage);
+        borders.push_back(chunkBorders ? *chunkBorders : ChunkBorders());
+        hasBorders.push_back(chunkBorders != nullptr);
+    }
+};
+
+static MeshFixture makeCheckerboard() {
+    PaletteStorage storage(CHUNK_VOLUME);
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            for (int x = 0; x < CHUNK_SIZE; ++x) {
+                if ((x + y + z) & 1) {
+                    storage.set(x + y * CHUNK_SIZE + z * CHUNK_AREA, static_cast<uint8_t>(1 + x % 3));
+                }
+            }
+        }
+    }
+    MeshFixture fixture;
+    fixture.add(storage, nullptr);
+    return fixture;
+}
+
+// Surface chunks of a block of generated terrain; the outer ring of the
+// block only supplies neighbour borders
+static MeshFixture makeTerrain() {
+    const int radius = 4;
+    const int minY = worldToChunk(TerrainConfig::MIN_HEIGHT) - 2;
+    const int maxY = worldToChunk(TerrainConfig::MAX_HEIGHT) + 1;
+    const int width = 2 * radius + 1;
+    const int height = maxY - minY + 1;
+
+    std::vector<Chunk*> chunks;
+    for (int y = minY; y <= maxY; ++y) {
+        for (int z = -radius; z <= radius; ++z) {
+            for (int x = -radius; x <= radius; ++x) {
+                Chunk* chunk = new Chunk(x, y, z);
+                chunk->load();
+                chunks.push_back(chunk);
+            }
+        }
+    }
+    auto chunkAt = [&](int x, int y, int z) {
+        return chunks[(x + radius) + (z + radius) * width + (y - minY) * width * width];
+    };
+
+    MeshFixture fixture;
+    ChunkBorders chunkBorders;
+    for (int y = minY + 1; y < minY + height - 1; ++y) {
+        for (int z = -radius + 1; z < radius; ++z) {
+            for (int x = -radius + 1; x < radius; ++x) {
+                const Chunk* chunk = chunkAt(x, y, z);
+                if (chunk->isUniform()) {
+                    continue;
+                }
+                for (int face = 0; face < FACE_COUNT; ++face) {
+                    const Chunk* neighbour = chunkAt(x + CHUNK_FACE_OFFSETS[face][0],
+                                                     y + CHUNK_FACE_OFFSETS[face][1],
+                                                     z + CHUNK_FACE_OFFSETS[face][2]);
+                    neighbour->copyBorderLayer(face ^ 1, chunkBorders.layers[face]);
+                }
+                fixture.add(chunk->getVoxelStorage(), &chunkBorders);
+            }
+        }
+    }
+
+    for (Chunk* chunk : chunks) {
+        delete chunk;
+    }
+    return fixture;
+}
+
+static MeshFixture makeRandom() {
+    std::mt19937 rng(1);
+    MeshFixture fixture;
+    for (int i = 0; i < 64; ++i) {
+        PaletteStorage storage(CHUNK_VOLUME);
+        for (int index = 0; index < CHUNK_VOLUME; ++index) {
+            if (rng() % 100 < 5) {
+                storage.set(index, static_cast<uint8_t>(1 + rng() % 4));
+            }
+        }
+        // Every other chunk gets equally sparse neighbour layers
+        ChunkBorders chunkBorders;
+        for (int face = 0; face < FACE_COUNT; ++face) {
+            for (int index = 0; index < CHUNK_AREA; ++index) {
+                chunkBorders.layers[face][index] = rng() % 100 < 5 ? static_cast<uint8_t>(1 + rng() % 4) : 0;
+            }
+        }
+        fixture.add(storage, (i & 1) ? &chunkBorders : nullptr);
+    }
+    return fixture;
+}
+
+// Number of fixture chunks whose mesh from `algorithm` differs from the
+// reference mesh (vertices or face ranges)
+static size_t countMismatches(const MeshFixture& fixture, MeshAlgorithm algorithm) {
+    std::vector<Vertex> reference;
+    std::vector<Vertex> binary;
+    MeshFaceRanges referenceRanges;
+    MeshFaceRanges binaryRanges;
+    size_t mismatches = 0;
+    for (size_t i = 0; i < fixture.voxels.size(); ++i) {
+        const ChunkBorders* borders = fixture.hasBorders[i] ? &fixture.borders[i] : nullptr;
+        MeshGenerator::generateMesh(fixture.voxels[i], borders, reference, referenceRanges, MESH_ALGORITHM_REFERENCE);
+        MeshGenerator::generateMesh(fixture.voxels[i], borders, binary, binaryRanges, algorithm);
+        if (reference.size() != binary.size() ||
+            std::memcmp(reference.data(), binary.data(), reference.size() * sizeof(Vertex)) != 0 ||
+            std::memcmp(&referenceRanges, &binaryRanges, sizeof(MeshFaceRanges)) != 0) {
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+struct MesherResult {
+    double quadsPerSecond;
+    double microsecondsPerChunk;
+    size_t quadsPerPass;
+};
+
+static MesherResult timeMesher(const MeshFixture& fixture, MeshAlgorithm algorithm) {
+    std::vector<Vertex> vertices;
+    MeshFaceRanges faceRanges;
+    size_t quads = 0;
+    size_t meshes = 0;
+    size_t passes = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    double seconds = 0.0;
+    while (seconds < MIN_SECONDS) {
+        for (size_t i = 0; i < fixture.voxels.size(); ++i) {
+            MeshGenerator::generateMesh(fixture.voxels[i], fixture.hasBorders[i] ? &fixture.borders[i] : nullptr,
+                                        vertices, faceRanges, algorithm);
+            quads += vertices.size() / QUAD_VERTEX_COUNT;
+        }
+        meshes += fixture.voxels.size();
+        ++passes;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    MesherResult result;
+    result.quadsPerSecond = static_cast<double>(quads) / seconds;
+    result.microsecondsPerChunk = seconds * 1e6 / static_cast<double>(meshes);
+    result.quadsPerPass = quads / passes;
+    return result;
+}
+
+// Returns false if the meshers disagree on the fixture (nothing is timed then)
+static bool benchFixture(const char* name, const MeshFixture& fixture) {
+    const MeshAlgorithm checked[2] = {MESH_ALGORITHM_BINARY_ADDQUAD, MESH_ALGORITHM_BINARY};
+    const char* checkedNames[2] = {"addQuad", "templated"};
+    for (int k = 0; k < 2; ++k) {
+        const size_t mismatches = countMismatches(fixture, checked[k]);
+        if (mismatches > 0) {
+            std::printf("%-13s binary mesh (%s emission) differs from the reference in %zu of %zu chunks\n",
+                        name, checkedNames[k], mismatches, fixture.voxels.size());
+            return false;
+        }
+    }
+
+    const MesherResult addQuad = timeMesher(fixture, MESH_ALGORITHM_BINARY_ADDQUAD);
+    const MesherResult templated = timeMesher(fixture, MESH_ALGORITHM_BINARY);
+    const MesherResult reference = timeMesher(fixture, MESH_ALGORITHM_REFERENCE);
+    std::printf("%-13s %6zu %9zu  %10.2f %10.1f  %10.2f %10.1f  %6.2fx  %10.2f %10.1f\n",
+                name, fixture.voxels.size(), templated.quadsPerPass,
+                addQuad.quadsPerSecond / 1e6, addQuad.microsecondsPerChunk,
+                templated.quadsPerSecond / 1e6, templated.microsecondsPerChunk,
+                templated.quadsPerSecond / addQuad.quadsPerSecond,
+                reference.quadsPerSecond / 1e6, reference.microsecondsPerChunk);
+    return true;
+}
+
+int main() {
+    std::printf("%-13s %6s %9s  %21s  %21s  %7s  %21s\n",
+                "", "", "", "binary, addQuad", "binary, templated", "", "reference");
+    std::printf("%-13s %6s %9s  %10s %10s  %10s %10s  %7s  %10s %10s\n",
+                "fixture", "chunks", "quads", "Mquads/s", "us/chunk", "Mquads/s", "us/chunk", "speedup",
+                "Mquads/s", "us/chunk");
+    bool identical = benchFixture("checkerboard", makeCheckerboard());
+    identical &= benchFixture("terrain", makeTerrain());
+    identical &= benchFixture("random 5%", makeRandom());
+    return identical ? 0 : 1;
+}
@@ -30,9 +30,16 @@ void Application::init() {
     chunkManager = new ChunkManager();
     chunkManager->init();
     
+    // Per-frame streaming budgets (generation, meshing and upload)
+    chunkManager->setStreamingConfig(streamingConfig);
+    renderer->setStreamingConfig(streamingConfig);
+    
     // Position camera above terrain
     Camera* camera = renderer->getCamera();
     if (camera) {
+        // See the whole streaming window (reverse-Z keeps depth precision)
+        camera->setFarPlane(static_cast<float>((streamingConfig.horizontalDistance + 2) * CHUNK_SIZE));
+        
         // Get terrain height at spawn position (0, 0)
         float spawnX = 0.0f;
         float spawnZ = 0.0f;
@@ -73,12 +80,18 @@ void Application::run() {
         if (camera) {
             camera->update(deltaTime);
             
-            // Update chunks around camera position with render distance of 10 chunks
+            // Load chunks in front of the camera first
+            float viewX, viewY, viewZ;
+            camera->getViewDirection(viewX, viewY, viewZ);
+            chunkManager->setViewDirection(viewX, viewY, viewZ);
+            
+            // Update chunks around camera position
             chunkManager->updateChunksAroundCamera(
                 camera->getPosX(), 
                 camera->getPosY(), 
                 camera->getPosZ(), 
-                10  // render distance in chunks
+                streamingConfig.horizontalDistance,
+                streamingConfig.verticalDistance
             );
         }
         
@@ -105,7 +118,10 @@ void Application::run() {
         } else if (camera) {
             std::cout << "[Frame] Render time: " << renderTimeMs << " ms"
                       << " | Camera Pos: (" << camera->getPosX() << ", " << camera->getPosY() << ", " << camera->getPosZ() << ")"
-                      << " | Yaw: " << camera->getYaw() << " Pitch: " << camera->getPitch() << std::endl;
+                      << " | Yaw: " << camera->getYaw() << " Pitch: " << camera->getPitch()
+                      << " | Chunks drawn: " << renderer->getDrawnChunkCount()
+                      << " culled: " << renderer->getCulledChunkCount()
+                      << " occluded: " << renderer->getOccludedChunkCount() << std::endl;
         } else {
             std::cout << "[Frame] Render time: " << renderTimeMs << " ms" << std::endl;
         }
@@ -2,6 +2,7 @@
 #define APPLICATION_H
 
 #include "window.h"
+#include "world/streaming_config.h"
 
 class Renderer;
 class ChunkManager;
@@ -20,6 +21,7 @@ private:
     Window* window;
     Renderer* renderer;
     ChunkManager* chunkManager;
+    StreamingConfig streamingConfig;
     bool isRunning;
     
     // Timing
@@ -135,6 +135,8 @@ void Camera::getViewMatrix(float* matrix) const {
 
 void Camera::getProjectionMatrix(float* matrix, float aspectRatio) const {
     // Perspective projection matrix for Vulkan (right-handed, Y-down, Z in [0, 1])
+    // Reverse-Z: the near plane maps to depth 1 and the far plane to 0, which
+    // spreads floating-point depth precision evenly over distance
     // Column-major order for Vulkan/GLSL
     float fovRad = fov * M_PI / 180.0f;
     float tanHalfFov = std::tan(fovRad / 2.0f);
@@ -143,9 +145,19 @@ void Camera::getProjectionMatrix(float* matrix, float aspectRatio) const {
     
     matrix[0] = 1.0f / (aspectRatio * tanHalfFov);
     matrix[5] = -1.0f / tanHalfFov; // Negative for Vulkan's Y-down
-    matrix[10] = -farPlane / (farPlane - nearPlane); // Negative for correct Z-depth mapping
+    matrix[10] = nearPlane / (farPlane - nearPlane);
     matrix[11] = -1.0f; // Negative to ensure W_clip = -Z_view (positive for visible points)
-    matrix[14] = -(farPlane * nearPlane) / (farPlane - nearPlane);
+    matrix[14] = (farPlane * nearPlane) / (farPlane - nearPlane);
+}
+
+void Camera::getViewDirection(float& dirX, float& dirY, float& dirZ) const {
+    // The view matrix maps the look direction to -Z, so it is the negated
+    // third row of its rotation part
+    float view[16];
+    getViewMatrix(view);
+    dirX = -view[2];
+    dirY = -view[6];
+    dirZ = -view[10];
 }
 
 void Camera::getMVPMatrix(float* mvp, float aspectRatio) const {
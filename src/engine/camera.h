@@ -24,6 +24,7 @@ public:
     void setRotation(float yaw, float pitch);
     void setMoveSpeed(float speed) { moveSpeed = speed; }
     void setRotationSpeed(float speed) { rotationSpeed = speed; }
+    void setFarPlane(float distance) { farPlane = distance; }
     
     float getPositionX() const { return posX; }
     float getPositionY() const { return posY; }
@@ -33,6 +34,9 @@ public:
     float getPosZ() const;
     float getYaw() const { return yaw; }
     float getPitch() const { return pitch; }
+    
+    // Unit vector the camera looks along, in world space
+    void getViewDirection(float& dirX, float& dirY, float& dirZ) const;
 
 private:
     // Camera position
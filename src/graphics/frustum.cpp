@@ -0,0 +1,97 @@
+#include "frustum.h"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_USE_SSE 1
+#endif
+
+Frustum::Frustum() {
+    // Until planes are extracted everything is visible
+    for (int i = 0; i < 6; ++i) {
+        planes[i][0] = planes[i][1] = planes[i][2] = 0.0f;
+        planes[i][3] = 1.0f;
+    }
+}
+
+void Frustum::extractPlanes(const float* mvp) {
+    // Row r of a column-major matrix is (m[r], m[4 + r], m[8 + r], m[12 + r])
+    auto row = [mvp](int r, int c) { return mvp[c * 4 + r]; };
+
+    for (int c = 0; c < 4; ++c) {
+        planes[0][c] = row(3, c) + row(0, c);  // Left:   -w <= x
+        planes[1][c] = row(3, c) - row(0, c);  // Right:   x <= w
+        planes[2][c] = row(3, c) + row(1, c);  // Bottom: -w <= y
+        planes[3][c] = row(3, c) - row(1, c);  // Top:     y <= w
+        planes[4][c] = row(2, c);              // Far:     0 <= z (reverse-Z)
+        planes[5][c] = row(3, c) - row(2, c);  // Near:    z <= w
+    }
+
+    // Normalise so distances are in world units
+    for (int i = 0; i < 6; ++i) {
+        float length = std::sqrt(planes[i][0] * planes[i][0] +
+                                 planes[i][1] * planes[i][1] +
+                                 planes[i][2] * planes[i][2]);
+        if (length > 0.0f) {
+            for (int c = 0; c < 4; ++c) {
+                planes[i][c] /= length;
+            }
+        }
+    }
+}
+
+bool Frustum::testAABB(float minX, float minY, float minZ,
+                       float maxX, float maxY, float maxZ) const {
+    for (int i = 0; i < 6; ++i) {
+        const float* p = planes[i];
+        float x = (p[0] >= 0.0f) ? maxX : minX;
+        float y = (p[1] >= 0.0f) ? maxY : minY;
+        float z = (p[2] >= 0.0f) ? maxZ : minZ;
+        if (p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t Frustum::testAABBs(const float* minX, const float* minY, const float* minZ,
+                          const float* maxX, const float* maxY, const float* maxZ,
+                          size_t count, uint8_t* visible) const {
+    size_t visibleCount = 0;
+    size_t i = 0;
+
+#ifdef FRUSTUM_USE_SSE
+    // The positive vertex only depends on the plane's signs, so each plane
+    // picks its min/max arrays once and evaluates four boxes per instruction
+    for (; i + 4 <= count; i += 4) {
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            const float* plane = planes[p];
+            __m128 x = _mm_loadu_ps((plane[0] >= 0.0f ? maxX : minX) + i);
+            __m128 y = _mm_loadu_ps((plane[1] >= 0.0f ? maxY : minY) + i);
+            __m128 z = _mm_loadu_ps((plane[2] >= 0.0f ? maxZ : minZ) + i);
+
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane[0])), _mm_mul_ps(y, _mm_set1_ps(plane[1]))),
+                _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane[2])), _mm_set1_ps(plane[3])));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+
+        const int mask = _mm_movemask_ps(inside);
+        for (int k = 0; k < 4; ++k) {
+            const uint8_t isVisible = static_cast<uint8_t>((mask >> k) & 1);
+            visible[i + k] = isVisible;
+            visibleCount += isVisible;
+        }
+    }
+#endif
+
+    // Remaining boxes (or all of them without SSE)
+    for (; i < count; ++i) {
+        const uint8_t isVisible = testAABB(minX[i], minY[i], minZ[i], maxX[i], maxY[i], maxZ[i]) ? 1 : 0;
+        visible[i] = isVisible;
+        visibleCount += isVisible;
+    }
+
+    return visibleCount;
+}
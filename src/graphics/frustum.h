@@ -0,0 +1,37 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// View frustum as six planes extracted from a clip matrix
+//
+// Planes are stored as (a, b, c, d) with the normal pointing inwards, so a
+// point p is inside a plane when a*p.x + b*p.y + c*p.z + d >= 0. Boxes are
+// tested against the plane with their "positive vertex" (the corner furthest
+// along the normal); a box is culled if that corner is outside any plane.
+// The test is conservative: some boxes near frustum corners pass although
+// they are not visible.
+class Frustum {
+public:
+    Frustum();
+
+    // Extract planes from a column-major clip matrix (e.g. Camera::getMVPMatrix)
+    // using Vulkan's clip space (0 <= z <= w)
+    void extractPlanes(const float* mvp);
+
+    bool testAABB(float minX, float minY, float minZ,
+                  float maxX, float maxY, float maxZ) const;
+
+    // Test `count` boxes stored as separate min/max coordinate arrays and
+    // write 1 (visible) or 0 (culled) per box. Uses SSE2 four boxes at a time
+    // where available. Returns the number of visible boxes.
+    size_t testAABBs(const float* minX, const float* minY, const float* minZ,
+                     const float* maxX, const float* maxY, const float* maxZ,
+                     size_t count, uint8_t* visible) const;
+
+private:
+    float planes[6][4];
+};
+
+#endif // FRUSTUM_H
@@ -0,0 +1,191 @@
+#include "geometry_pool.h"
+#include "staging_uploader.h"
+#include <stdexcept>
+
+GeometryPool::GeometryPool(VkDevice device, VkPhysicalDevice physicalDevice)
+    : device(device), physicalDevice(physicalDevice), uploader(nullptr),
+      queueFamilies{0, 0}, pageVertexCapacity(0),
+      quadIndexBuffer(VK_NULL_HANDLE), quadIndexMemory(VK_NULL_HANDLE), currentFrame(0) {
+}
+
+GeometryPool::~GeometryPool() {
+    cleanup();
+}
+
+void GeometryPool::init(size_t framesInFlight, StagingUploader* uploader,
+                        uint32_t graphicsQueueFamily, uint32_t transferQueueFamily,
+                        uint32_t pageVertexCapacity) {
+    this->uploader = uploader;
+    queueFamilies[0] = graphicsQueueFamily;
+    queueFamilies[1] = transferQueueFamily;
+    this->pageVertexCapacity = pageVertexCapacity;
+    pendingFrees.assign(framesInFlight, std::vector<GeometryAllocation>());
+    currentFrame = 0;
+
+    createQuadIndexBuffer();
+}
+
+void GeometryPool::cleanup() {
+    for (Page& page : pages) {
+        vkDestroyBuffer(device, page.vertexBuffer, nullptr);
+        vkFreeMemory(device, page.vertexMemory, nullptr);
+    }
+    pages.clear();
+    pendingFrees.clear();
+
+    if (quadIndexBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, quadIndexBuffer, nullptr);
+        vkFreeMemory(device, quadIndexMemory, nullptr);
+        quadIndexBuffer = VK_NULL_HANDLE;
+        quadIndexMemory = VK_NULL_HANDLE;
+    }
+}
+
+bool GeometryPool::allocate(const std::vector<Vertex>& vertices, GeometryAllocation& allocation) {
+    const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+    if (vertexCount > pageVertexCapacity || vertexCount > MAX_MESH_QUADS * QUAD_VERTEX_COUNT) {
+        throw std::runtime_error("Mesh is too large for a geometry pool page!");
+    }
+    
+    const VkDeviceSize vertexBytes = sizeof(Vertex) * static_cast<VkDeviceSize>(vertexCount);
+    if (!uploader->reserve(vertexBytes)) {
+        return false;
+    }
+
+    allocation = GeometryAllocation{};
+    allocation.vertexCount = vertexCount;
+
+    // First page with room; grow the pool otherwise
+    bool found = false;
+    for (uint32_t i = 0; i < pages.size() && !found; ++i) {
+        if (pages[i].vertexRanges.allocate(vertexCount, allocation.vertexOffset)) {
+            allocation.page = i;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        createPage();
+        allocation.page = static_cast<uint32_t>(pages.size() - 1);
+        pages.back().vertexRanges.allocate(vertexCount, allocation.vertexOffset);
+    }
+
+    // The target range is not in use by the GPU; the graphics submit that
+    // first draws it waits for the transfer to finish
+    const Page& page = pages[allocation.page];
+    uploader->stage(vertices.data(), vertexBytes, page.vertexBuffer,
+                    sizeof(Vertex) * static_cast<VkDeviceSize>(allocation.vertexOffset));
+
+    return true;
+}
+
+void GeometryPool::free(const GeometryAllocation& allocation) {
+    if (pendingFrees.empty()) {
+        releaseRanges(allocation);
+        return;
+    }
+    pendingFrees[currentFrame].push_back(allocation);
+}
+
+void GeometryPool::beginFrame(size_t frameIndex) {
+    currentFrame = frameIndex;
+
+    // Everything freed while this slot was last recorded is now idle
+    for (const GeometryAllocation& allocation : pendingFrees[frameIndex]) {
+        releaseRanges(allocation);
+    }
+    pendingFrees[frameIndex].clear();
+}
+
+void GeometryPool::releaseRanges(const GeometryAllocation& allocation) {
+    if (allocation.page >= pages.size()) {
+        return;
+    }
+    pages[allocation.page].vertexRanges.free(allocation.vertexOffset, allocation.vertexCount);
+}
+
+void GeometryPool::createQuadIndexBuffer() {
+    std::vector<uint16_t> indices(MAX_MESH_QUADS * QUAD_INDEX_COUNT);
+    for (uint32_t quad = 0; quad < MAX_MESH_QUADS; ++quad) {
+        for (uint32_t i = 0; i < QUAD_INDEX_COUNT; ++i) {
+            indices[quad * QUAD_INDEX_COUNT + i] =
+                static_cast<uint16_t>(quad * QUAD_VERTEX_COUNT + QUAD_INDEX_PATTERN[i]);
+        }
+    }
+
+    const VkDeviceSize indexBytes = sizeof(uint16_t) * static_cast<VkDeviceSize>(indices.size());
+    createBuffer(indexBytes,
+                 VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                 quadIndexBuffer, quadIndexMemory);
+
+    // Nothing is in flight yet, so the staging space is always there. The
+    // first frame's submission waits for this copy like any mesh upload.
+    if (!uploader->reserve(indexBytes)) {
+        throw std::runtime_error("Failed to stage the quad index buffer!");
+    }
+    uploader->stage(indices.data(), indexBytes, quadIndexBuffer, 0);
+    uploader->flush();
+}
+
+void GeometryPool::createPage() {
+    Page page{};
+
+    createBuffer(sizeof(Vertex) * static_cast<VkDeviceSize>(pageVertexCapacity),
+                 VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                 page.vertexBuffer, page.vertexMemory);
+    page.vertexRanges.init(pageVertexCapacity);
+
+    pages.push_back(page);
+}
+
+void GeometryPool::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
+                                VkMemoryPropertyFlags properties, VkBuffer& buffer,
+                                VkDeviceMemory& bufferMemory) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    if (queueFamilies[0] != queueFamilies[1]) {
+        bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = 2;
+        bufferInfo.pQueueFamilyIndices = queueFamilies;
+    } else {
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create geometry pool buffer!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate geometry pool memory!");
+    }
+
+    if (vkBindBufferMemory(device, buffer, bufferMemory, 0) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to bind geometry pool memory!");
+    }
+}
+
+uint32_t GeometryPool::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1 << i)) &&
+            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("Failed to find suitable memory type!");
+}
@@ -0,0 +1,92 @@
+#ifndef GEOMETRY_POOL_H
+#define GEOMETRY_POOL_H
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+#include "utils/range_allocator.h"
+
+class StagingUploader;
+
+// Shared storage for all chunk geometry
+//
+// Instead of one VkBuffer + vkAllocateMemory pair per mesh, geometry lives in
+// a few large vertex buffer "pages". A mesh is a range of vertices inside one
+// page, handed out by a free-list allocator. New pages are created only when
+// no existing page has room, so the number of device allocations stays tiny.
+//
+// Meshes are quad lists (see QUAD_INDEX_PATTERN in mesh.h), so they carry no
+// indices: one read-only 16-bit index buffer, sized for MAX_MESH_QUADS and
+// uploaded once in init(), serves every draw.
+//
+// Pages live in device-local memory and are filled through a StagingUploader
+// on the transfer queue. If the transfer queue belongs to another family than
+// graphics, pages use concurrent sharing so no ownership transfers are needed.
+//
+// Draws start at index 0 of the quad index buffer and pass the mesh's
+// vertexOffset as the vertex offset.
+//
+// Released ranges may still be read by frames in flight. free() therefore
+// parks them in the bucket of the current frame slot, and they return to the
+// allocator when beginFrame() is called for that slot again, i.e. after its
+// fence has signalled.
+class GeometryPool {
+public:
+    static const uint32_t DEFAULT_PAGE_VERTICES = 1u << 22;  // 32 MiB of vertices
+
+    GeometryPool(VkDevice device, VkPhysicalDevice physicalDevice);
+    ~GeometryPool();
+
+    void init(size_t framesInFlight, StagingUploader* uploader,
+              uint32_t graphicsQueueFamily, uint32_t transferQueueFamily,
+              uint32_t pageVertexCapacity = DEFAULT_PAGE_VERTICES);
+    void cleanup();
+
+    // Reserve a range for a mesh and stage its vertices for upload. Returns
+    // false (allocating nothing) if the uploader has no staging space left
+    // this frame.
+    bool allocate(const std::vector<Vertex>& vertices, GeometryAllocation& allocation);
+
+    // Release a mesh's range once the GPU can no longer be reading them
+    void free(const GeometryAllocation& allocation);
+
+    // Call after waiting on the fence of frame slot `frameIndex`
+    void beginFrame(size_t frameIndex);
+
+    VkBuffer getVertexBuffer(uint32_t page) const { return pages[page].vertexBuffer; }
+    VkBuffer getQuadIndexBuffer() const { return quadIndexBuffer; }
+    size_t getPageCount() const { return pages.size(); }
+
+private:
+    struct Page {
+        VkBuffer vertexBuffer;
+        VkDeviceMemory vertexMemory;
+        RangeAllocator vertexRanges;
+    };
+
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    StagingUploader* uploader;
+    uint32_t queueFamilies[2];  // Graphics, transfer
+    uint32_t pageVertexCapacity;
+    std::vector<Page> pages;
+
+    VkBuffer quadIndexBuffer;
+    VkDeviceMemory quadIndexMemory;
+
+    // Deferred frees, one bucket per frame slot
+    std::vector<std::vector<GeometryAllocation>> pendingFrees;
+    size_t currentFrame;
+
+    void createQuadIndexBuffer();
+    void createPage();
+    void releaseRanges(const GeometryAllocation& allocation);
+    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
+                      VkMemoryPropertyFlags properties, VkBuffer& buffer,
+                      VkDeviceMemory& bufferMemory);
+    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+};
+
+#endif // GEOMETRY_POOL_H
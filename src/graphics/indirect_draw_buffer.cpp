@@ -0,0 +1,113 @@
+#include "indirect_draw_buffer.h"
+#include <stdexcept>
+
+IndirectDrawBuffer::IndirectDrawBuffer(VkDevice device, VkPhysicalDevice physicalDevice)
+    : device(device), physicalDevice(physicalDevice) {
+}
+
+IndirectDrawBuffer::~IndirectDrawBuffer() {
+    cleanup();
+}
+
+void IndirectDrawBuffer::init(size_t framesInFlight, uint32_t initialCapacity) {
+    slots.resize(framesInFlight);
+    for (Slot& slot : slots) {
+        createSlot(slot, initialCapacity);
+    }
+}
+
+void IndirectDrawBuffer::cleanup() {
+    for (Slot& slot : slots) {
+        destroySlot(slot);
+    }
+    slots.clear();
+}
+
+bool IndirectDrawBuffer::reserve(size_t frameIndex, uint32_t drawCount) {
+    Slot& slot = slots[frameIndex];
+    if (drawCount <= slot.capacity) {
+        return false;
+    }
+
+    uint32_t capacity = slot.capacity;
+    while (capacity < drawCount) {
+        capacity *= 2;
+    }
+
+    // The slot's last frame has finished, so its buffers are idle
+    destroySlot(slot);
+    createSlot(slot, capacity);
+    return true;
+}
+
+void IndirectDrawBuffer::createSlot(Slot& slot, uint32_t capacity) {
+    slot = Slot{};
+    slot.capacity = capacity > 0 ? capacity : 1;
+
+    void* mapped = nullptr;
+    createBuffer(sizeof(VkDrawIndexedIndirectCommand) * static_cast<VkDeviceSize>(slot.capacity),
+                 VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, slot.commandBuffer, slot.commandMemory, &mapped);
+    slot.commands = static_cast<VkDrawIndexedIndirectCommand*>(mapped);
+
+    createBuffer(sizeof(ChunkDrawData) * static_cast<VkDeviceSize>(slot.capacity),
+                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, slot.drawDataBuffer, slot.drawDataMemory, &mapped);
+    slot.drawData = static_cast<ChunkDrawData*>(mapped);
+}
+
+void IndirectDrawBuffer::destroySlot(Slot& slot) {
+    // Freeing the memory unmaps it
+    vkDestroyBuffer(device, slot.commandBuffer, nullptr);
+    vkFreeMemory(device, slot.commandMemory, nullptr);
+    vkDestroyBuffer(device, slot.drawDataBuffer, nullptr);
+    vkFreeMemory(device, slot.drawDataMemory, nullptr);
+    slot = Slot{};
+}
+
+void IndirectDrawBuffer::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer& buffer,
+                                      VkDeviceMemory& bufferMemory, void** mapped) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create indirect draw buffer!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate indirect draw buffer memory!");
+    }
+
+    if (vkBindBufferMemory(device, buffer, bufferMemory, 0) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to bind indirect draw buffer memory!");
+    }
+
+    // Stays mapped for the buffer's lifetime
+    if (vkMapMemory(device, bufferMemory, 0, size, 0, mapped) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to map indirect draw buffer memory!");
+    }
+}
+
+uint32_t IndirectDrawBuffer::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1 << i)) &&
+            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("Failed to find suitable memory type!");
+}
@@ -0,0 +1,73 @@
+#ifndef INDIRECT_DRAW_BUFFER_H
+#define INDIRECT_DRAW_BUFFER_H
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Per-chunk data read by the chunk vertex shader (storage buffer, binding 1).
+// Every draw of chunk i uses firstInstance = i, so the shader finds its entry
+// through gl_InstanceIndex.
+struct ChunkDrawData {
+    float origin[4];  // World position of the chunk's minimum corner; w unused
+};
+
+// Host-visible draw command and per-draw data arrays, one pair per frame slot
+//
+// The renderer fills the slot of the frame being recorded with the
+// VkDrawIndexedIndirectCommands of the visible chunks (one per drawn range of
+// face directions) and one ChunkDrawData per chunk, then submits them with
+// vkCmdDrawIndexedIndirect. Both arrays share one capacity, are persistently
+// mapped and coherent, so writes need no flush. A slot is only written after
+// its frame fence has signalled, so it is never read by the GPU at the same
+// time; when it is too small it is recreated with twice the capacity.
+class IndirectDrawBuffer {
+public:
+    static const uint32_t DEFAULT_CAPACITY = 4096;
+
+    IndirectDrawBuffer(VkDevice device, VkPhysicalDevice physicalDevice);
+    ~IndirectDrawBuffer();
+
+    void init(size_t framesInFlight, uint32_t initialCapacity = DEFAULT_CAPACITY);
+    void cleanup();
+
+    // Make room for `drawCount` commands and draw data entries in frame slot
+    // `frameIndex`. Returns true if the slot's buffers were recreated, in
+    // which case descriptors that reference the draw data buffer must be
+    // rewritten.
+    bool reserve(size_t frameIndex, uint32_t drawCount);
+
+    VkDrawIndexedIndirectCommand* getCommands(size_t frameIndex) { return slots[frameIndex].commands; }
+    ChunkDrawData* getDrawData(size_t frameIndex) { return slots[frameIndex].drawData; }
+    VkBuffer getCommandBuffer(size_t frameIndex) const { return slots[frameIndex].commandBuffer; }
+    VkBuffer getDrawDataBuffer(size_t frameIndex) const { return slots[frameIndex].drawDataBuffer; }
+    VkDeviceSize getDrawDataSize(size_t frameIndex) const {
+        return sizeof(ChunkDrawData) * static_cast<VkDeviceSize>(slots[frameIndex].capacity);
+    }
+
+private:
+    struct Slot {
+        uint32_t capacity;
+
+        VkBuffer commandBuffer;
+        VkDeviceMemory commandMemory;
+        VkDrawIndexedIndirectCommand* commands;
+
+        VkBuffer drawDataBuffer;
+        VkDeviceMemory drawDataMemory;
+        ChunkDrawData* drawData;
+    };
+
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    std::vector<Slot> slots;
+
+    void createSlot(Slot& slot, uint32_t capacity);
+    void destroySlot(Slot& slot);
+    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer& buffer,
+                      VkDeviceMemory& bufferMemory, void** mapped);
+    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+};
+
+#endif // INDIRECT_DRAW_BUFFER_H
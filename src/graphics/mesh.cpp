@@ -1,106 +1,37 @@
 #include "mesh.h"
-#include <stdexcept>
-#include <cstring>
+#include "geometry_pool.h"
 
-Mesh::Mesh(VkDevice device, VkPhysicalDevice physicalDevice)
-    : device(device), physicalDevice(physicalDevice), 
-      vertexBuffer(VK_NULL_HANDLE), vertexBufferMemory(VK_NULL_HANDLE),
-      indexBuffer(VK_NULL_HANDLE), indexBufferMemory(VK_NULL_HANDLE),
-      indexCount(0), vertexCount(0) {
+Mesh::Mesh(GeometryPool* pool)
+    : pool(pool), allocation{}, faceRanges{}, allocated(false) {
 }
 
 Mesh::~Mesh() {
     cleanup();
 }
 
-void Mesh::createVertexBuffer(const std::vector<Vertex>& vertices) {
+bool Mesh::create(const std::vector<Vertex>& vertices, const MeshFaceRanges& faceRanges) {
+    cleanup();
+    
+    if (!pool->allocate(vertices, allocation)) {
+        return false;
+    }
+    allocated = true;
+    this->faceRanges = faceRanges;
+    
     // Store vertices for debug access
     this->vertices = vertices;
-    vertexCount = static_cast<uint32_t>(vertices.size());
-    
-    VkDeviceSize bufferSize = sizeof(Vertex) * vertices.size();
-
-    createBuffer(bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                vertexBuffer, vertexBufferMemory);
-
-    void* data;
-    vkMapMemory(device, vertexBufferMemory, 0, bufferSize, 0, &data);
-    memcpy(data, vertices.data(), static_cast<size_t>(bufferSize));
-    vkUnmapMemory(device, vertexBufferMemory);
-}
-
-void Mesh::createIndexBuffer(const std::vector<uint32_t>& indices) {
-    indexCount = static_cast<uint32_t>(indices.size());
-    VkDeviceSize bufferSize = sizeof(uint32_t) * indices.size();
-
-    createBuffer(bufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                indexBuffer, indexBufferMemory);
-
-    void* data;
-    vkMapMemory(device, indexBufferMemory, 0, bufferSize, 0, &data);
-    memcpy(data, indices.data(), static_cast<size_t>(bufferSize));
-    vkUnmapMemory(device, indexBufferMemory);
+    return true;
 }
 
 void Mesh::cleanup() {
-    if (indexBuffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(device, indexBuffer, nullptr);
-        indexBuffer = VK_NULL_HANDLE;
-    }
-    if (indexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device, indexBufferMemory, nullptr);
-        indexBufferMemory = VK_NULL_HANDLE;
-    }
-    if (vertexBuffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(device, vertexBuffer, nullptr);
-        vertexBuffer = VK_NULL_HANDLE;
-    }
-    if (vertexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device, vertexBufferMemory, nullptr);
-        vertexBufferMemory = VK_NULL_HANDLE;
+    if (allocated) {
+        // Ranges are recycled once the frames that may still read them finish
+        pool->free(allocation);
+        allocation = GeometryAllocation{};
+        allocated = false;
     }
 }
 
-void Mesh::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
-                       VkMemoryPropertyFlags properties, VkBuffer& buffer,
-                       VkDeviceMemory& bufferMemory) {
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = size;
-    bufferInfo.usage = usage;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create buffer!");
-    }
-
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate buffer memory!");
-    }
-
-    vkBindBufferMemory(device, buffer, bufferMemory, 0);
-}
-
-uint32_t Mesh::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
-
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) && 
-            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
-    }
-
-    throw std::runtime_error("Failed to find suitable memory type!");
+VkBuffer Mesh::getVertexBuffer() const {
+    return allocated ? pool->getVertexBuffer(allocation.page) : VK_NULL_HANDLE;
 }
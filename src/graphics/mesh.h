@@ -2,54 +2,108 @@
 #define MESH_H
 
 #include <vulkan/vulkan.h>
+#include <cstdint>
 #include <vector>
 
-// Vertex structure for voxel mesh rendering
+// Packed vertex for voxel mesh rendering (8 bytes)
+//
+// Positions are chunk-local: the shader adds the chunk origin, which it reads
+// per draw from a storage buffer (see ChunkDrawData in indirect_draw_buffer.h).
 // Memory layout matches shader expectations:
-//   location 0: vec3 position (12 bytes)
-//   location 1: vec3 normal (12 bytes)
-//   location 2: vec2 texCoord (8 bytes)
-// Total size: 32 bytes per vertex
+//   location 0: uint position  bits 0-4 x, 5-9 y, 10-14 z (0..CHUNK_SIZE),
+//                              bits 15-17 face (a ChunkFace, see chunk.h)
+//   location 1: uint surface   bits 0-4 u, 5-9 v (texture coordinates in
+//                              voxels, so textures tile across merged quads),
+//                              bits 10-17 voxel type
 struct Vertex {
-    float position[3];  // Vertex position in world space
-    float normal[3];    // Surface normal for lighting
-    float texCoord[2];  // Texture coordinates (UV mapping)
+    uint32_t position;
+    uint32_t surface;
 };
 
+namespace VertexPacking {
+    inline Vertex pack(int x, int y, int z, int face, int u, int v, uint8_t voxelType) {
+        Vertex vertex;
+        vertex.position = static_cast<uint32_t>(x) | (static_cast<uint32_t>(y) << 5) |
+                          (static_cast<uint32_t>(z) << 10) | (static_cast<uint32_t>(face) << 15);
+        vertex.surface = static_cast<uint32_t>(u) | (static_cast<uint32_t>(v) << 5) |
+                         (static_cast<uint32_t>(voxelType) << 10);
+        return vertex;
+    }
+
+    inline int getX(const Vertex& vertex) { return static_cast<int>(vertex.position & 31u); }
+    inline int getY(const Vertex& vertex) { return static_cast<int>((vertex.position >> 5) & 31u); }
+    inline int getZ(const Vertex& vertex) { return static_cast<int>((vertex.position >> 10) & 31u); }
+    inline int getFace(const Vertex& vertex) { return static_cast<int>((vertex.position >> 15) & 7u); }
+    inline int getU(const Vertex& vertex) { return static_cast<int>(vertex.surface & 31u); }
+    inline int getV(const Vertex& vertex) { return static_cast<int>((vertex.surface >> 5) & 31u); }
+    inline uint8_t getVoxelType(const Vertex& vertex) { return static_cast<uint8_t>(vertex.surface >> 10); }
+}
+
+// Chunk meshes are quad lists: quad q is vertices 4q..4q+3, drawn as the
+// triangles (4q, 4q+2, 4q+1) and (4q, 4q+3, 4q+2) with clockwise winding.
+// Every mesh shares one read-only index buffer holding this pattern (see
+// GeometryPool), so meshes store vertices only.
+constexpr uint32_t QUAD_VERTEX_COUNT = 4;
+constexpr uint32_t QUAD_INDEX_COUNT = 6;
+constexpr uint16_t QUAD_INDEX_PATTERN[QUAD_INDEX_COUNT] = {0, 2, 1, 0, 3, 2};
+
+// Most quads a chunk mesh can have. Faces are only emitted towards air, so a
+// row of 16 voxels along an axis yields at most 16 faces on that axis (a
+// solid/air checkerboard): 3 axes * 16^3. mesh_generator.cpp checks this
+// against CHUNK_SIZE.
+constexpr uint32_t MAX_MESH_QUADS = 3 * 16 * 16 * 16;
+static_assert(MAX_MESH_QUADS * QUAD_VERTEX_COUNT <= 65536, "Quad indices must fit in 16 bits");
+
+// Quads are grouped by face direction in ChunkFace order (-X, +X, -Y, +Y,
+// -Z, +Z), so whole directions that face away from the camera can be
+// skipped. Direction f covers vertices [start[f], start[f + 1]) of the mesh.
+struct MeshFaceRanges {
+    static const int DIRECTION_COUNT = 6;
+    uint32_t start[DIRECTION_COUNT + 1];
+};
+
+class GeometryPool;
+
+// Location of one mesh inside the geometry pool, in vertices (not bytes)
+struct GeometryAllocation {
+    uint32_t page;
+    uint32_t vertexOffset;
+    uint32_t vertexCount;
+};
+
+// A chunk mesh: a vertex range inside the shared GeometryPool, drawn with
+// the pool's quad index buffer and the mesh's first vertex as vertex offset
 class Mesh {
 public:
-    Mesh(VkDevice device, VkPhysicalDevice physicalDevice);
+    Mesh(GeometryPool* pool);
     ~Mesh();
 
-    void createVertexBuffer(const std::vector<Vertex>& vertices);
-    void createIndexBuffer(const std::vector<uint32_t>& indices);
+    // Returns false if the upload has to wait for staging space (see GeometryPool)
+    bool create(const std::vector<Vertex>& vertices, const MeshFaceRanges& faceRanges);
     void cleanup();
 
-    VkBuffer getVertexBuffer() const { return vertexBuffer; }
-    VkBuffer getIndexBuffer() const { return indexBuffer; }
-    uint32_t getIndexCount() const { return indexCount; }
-    uint32_t getVertexCount() const { return vertexCount; }
+    VkBuffer getVertexBuffer() const;
+    uint32_t getPage() const { return allocation.page; }
+    int32_t getVertexOffset() const { return static_cast<int32_t>(allocation.vertexOffset); }
+    uint32_t getVertexCount() const { return allocation.vertexCount; }
+    
+    // Indices to draw from the shared quad index buffer, starting at index 0
+    uint32_t getIndexCount() const { return allocation.vertexCount / QUAD_VERTEX_COUNT * QUAD_INDEX_COUNT; }
+    
+    // Vertex range of one face direction, relative to getVertexOffset()
+    const MeshFaceRanges& getFaceRanges() const { return faceRanges; }
     
     // Debug methods
     const std::vector<Vertex>& getVertices() const { return vertices; }
 
 private:
-    VkDevice device;
-    VkPhysicalDevice physicalDevice;
-    VkBuffer vertexBuffer;
-    VkDeviceMemory vertexBufferMemory;
-    VkBuffer indexBuffer;
-    VkDeviceMemory indexBufferMemory;
-    uint32_t indexCount;
-    uint32_t vertexCount;
+    GeometryPool* pool;
+    GeometryAllocation allocation;
+    MeshFaceRanges faceRanges;
+    bool allocated;
     
     // Store a copy of vertices for debug purposes
     std::vector<Vertex> vertices;
-
-    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, 
-                     VkMemoryPropertyFlags properties, VkBuffer& buffer, 
-                     VkDeviceMemory& bufferMemory);
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 };
 
 #endif // MESH_H
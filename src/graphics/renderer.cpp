@@ -7,28 +7,34 @@
 #include "vulkan/image_views.h"
 #include "vulkan/render_pass.h"
 #include "vulkan/framebuffers.h"
+#include "vulkan/depth_buffer.h"
 #include "vulkan/command_pool.h"
 #include "vulkan/sync_objects.h"
 #include "vulkan/pipeline.h"
 #include "vulkan/overlay_pipeline.h"
 #include "mesh.h"
+#include "geometry_pool.h"
+#include "staging_uploader.h"
+#include "indirect_draw_buffer.h"
 #include "world/chunk.h"
 #include "world/chunk_manager.h"
 #include "world/mesh_generator.h"
 #include <iostream>
 #include <stdexcept>
 #include <cstring>
+#include <cmath>
 #include <algorithm>
-#include <unordered_map>
-#include <tuple>
+#include <chrono>
 #include <GLFW/glfw3.h>
 
 Renderer::Renderer()
     : window(nullptr), vulkanInstance(nullptr), device(nullptr), swapchain(nullptr),
-      imageViews(nullptr), renderPass(nullptr), framebuffers(nullptr),
+      imageViews(nullptr), renderPass(nullptr), depthBuffer(nullptr), framebuffers(nullptr),
       commandPool(nullptr), syncObjects(nullptr), pipeline(nullptr), overlayPipeline(nullptr),
+      geometryPool(nullptr), stagingUploader(nullptr), indirectDrawBuffer(nullptr), meshBuildQueue(nullptr),
       overlayVertexBuffer(VK_NULL_HANDLE), overlayVertexBufferMemory(VK_NULL_HANDLE),
-      camera(nullptr), uniformBuffers(nullptr), uniformBuffersMemory(nullptr),
+      camera(nullptr), drawnChunkCount(0), culledChunkCount(0), occludedChunkCount(0),
+      uniformBuffers(nullptr), uniformBuffersMemory(nullptr),
       uniformBuffersMapped(nullptr), descriptorPool(VK_NULL_HANDLE),
       descriptorSets(nullptr), currentFrame(0), startTime(0.0) {
 }
@@ -60,11 +66,17 @@ void Renderer::init(Window* window) {
     
     // Create render pass
     renderPass = new RenderPass(device->getDevice());
-    renderPass->createRenderPass(swapchain->getSwapchainImageFormat());
+    renderPass->createRenderPass(swapchain->getSwapchainImageFormat(),
+                                 DepthBuffer::findDepthFormat(device->getPhysicalDevice()));
+    
+    // Create depth buffer
+    depthBuffer = new DepthBuffer(device->getDevice(), device->getPhysicalDevice());
+    depthBuffer->createDepthResources(swapchain->getSwapchainExtent());
     
     // Create framebuffers
     framebuffers = new Framebuffers(device->getDevice());
     framebuffers->createFramebuffers(imageViews->getImageViews(), 
+                                    depthBuffer->getImageView(),
                                     renderPass->getRenderPass(),
                                     swapchain->getSwapchainExtent());
     
@@ -88,6 +100,11 @@ void Renderer::init(Window* window) {
     // Create uniform buffers for MVP matrices
     createUniformBuffers();
     
+    // Per-frame indirect draw commands and chunk draw data (the descriptor
+    // sets reference the draw data buffers)
+    indirectDrawBuffer = new IndirectDrawBuffer(device->getDevice(), device->getPhysicalDevice());
+    indirectDrawBuffer->init(MAX_FRAMES_IN_FLIGHT);
+    
     // Create descriptor pool and sets
     createDescriptorPool();
     createDescriptorSets();
@@ -95,6 +112,20 @@ void Renderer::init(Window* window) {
     // Create overlay vertex buffer
     createOverlayVertexBuffer();
     
+    // Create the shared chunk geometry pool (device-local, filled by staged
+    // copies on the transfer queue)
+    stagingUploader = new StagingUploader(device->getDevice(), device->getPhysicalDevice(),
+                                          device->getTransferQueue(), device->getTransferQueueFamily());
+    stagingUploader->init(MAX_FRAMES_IN_FLIGHT);
+    
+    geometryPool = new GeometryPool(device->getDevice(), device->getPhysicalDevice());
+    geometryPool->init(MAX_FRAMES_IN_FLIGHT, stagingUploader,
+                       device->getGraphicsQueueFamily(), device->getTransferQueueFamily());
+    
+    // Start mesh workers
+    meshBuildQueue = new MeshBuildQueue();
+    meshBuildQueue->init();
+    
     // Create camera
     camera = new Camera();
     camera->setPosition(8.0f, 8.0f, 20.0f);
@@ -111,6 +142,10 @@ void Renderer::render() {
     const auto& fences = syncObjects->getInFlightFences();
     vkWaitForFences(device->getDevice(), 1, &fences[currentFrame], VK_TRUE, UINT64_MAX);
     
+    // Geometry ranges and staging batches last used by this frame slot are now idle
+    geometryPool->beginFrame(currentFrame);
+    stagingUploader->beginFrame(currentFrame);
+    
     // Acquire an image from the swapchain
     uint32_t imageIndex;
     const auto& imageAvailable = syncObjects->getImageAvailableSemaphores();
@@ -144,11 +179,18 @@ void Renderer::render() {
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     
-    VkSemaphore waitSemaphores[] = {imageAvailable[currentFrame]};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
+    // Wait for the swapchain image before writing colour, and for pending
+    // geometry uploads before fetching vertices
+    submitWaitSemaphores.clear();
+    submitWaitSemaphores.push_back(imageAvailable[currentFrame]);
+    stagingUploader->consumeWaitSemaphores(currentFrame, submitWaitSemaphores);
+    
+    submitWaitStages.assign(submitWaitSemaphores.size(), VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+    submitWaitStages[0] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(submitWaitSemaphores.size());
+    submitInfo.pWaitSemaphores = submitWaitSemaphores.data();
+    submitInfo.pWaitDstStageMask = submitWaitStages.data();
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffers[currentFrame];
     
@@ -202,77 +244,155 @@ void Renderer::recordCommandBuffer(size_t imageIndex) {
     renderPassInfo.renderArea.offset = {0, 0};
     renderPassInfo.renderArea.extent = swapchain->getSwapchainExtent();
     
-    VkClearValue clearColor = {{{0.0f, 0.0f, 0.2f, 1.0f}}};
-    renderPassInfo.clearValueCount = 1;
-    renderPassInfo.pClearValues = &clearColor;
+    // Depth clears to 0, the far plane under reverse-Z
+    VkClearValue clearValues[2]{};
+    clearValues[0].color = {{0.0f, 0.0f, 0.2f, 1.0f}};
+    clearValues[1].depthStencil = {0.0f, 0};
+    renderPassInfo.clearValueCount = 2;
+    renderPassInfo.pClearValues = clearValues;
     
     vkCmdBeginRenderPass(commandBuffers[currentFrame], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
     
     // Bind the graphics pipeline
     vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->getPipeline());
     
-    // Bind descriptor sets (for uniform buffers)
-    vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS,
-                           pipeline->getPipelineLayout(), 0, 1, &descriptorSets[currentFrame],
-                           0, nullptr);
-    
-    // Render all chunk meshes sorted by distance from camera
-    // This ensures correct rendering order, especially at different camera angles
-    std::vector<std::pair<std::tuple<int, int, int>, Mesh*>> sortedChunks;
-    sortedChunks.reserve(chunkMeshes.size());
-    for (const auto& pair : chunkMeshes) {
-        sortedChunks.push_back(pair);
-    }
-    
-    // Get camera position for distance calculation
+    // Frustum-cull the draw list bounds in one batched pass
+    const size_t meshCount = drawMeshes.size();
+    chunkVisible.resize(meshCount);
+    const size_t visibleCount = frustum.testAABBs(boundsMinX.data(), boundsMinY.data(), boundsMinZ.data(),
+                                                  boundsMaxX.data(), boundsMaxY.data(), boundsMaxZ.data(),
+                                                  meshCount, chunkVisible.data());
+    culledChunkCount = static_cast<uint32_t>(meshCount - visibleCount);
+    
+    // Chunks in view may still be sealed off from the camera by solid
+    // terrain (e.g. caves below the surface)
+    updateOcclusion();
+    occludedChunkCount = 0;
+    
+    // Draw opaque chunks roughly front-to-back so early depth testing
+    // rejects fragments hidden behind nearer chunks. Exact order does not
+    // matter for correctness, so chunks are bucketed by whole-chunk distance
+    // with a counting sort instead of being fully sorted every frame.
     const float camX = camera->getPositionX();
     const float camY = camera->getPositionY();
     const float camZ = camera->getPositionZ();
+    constexpr float halfChunk = CHUNK_SIZE / 2.0f;
+    constexpr float invChunkSize = 1.0f / CHUNK_SIZE;
+    
+    visibleSlots.clear();
+    visibleBuckets.clear();
+    std::fill(drawBucketOffsets, drawBucketOffsets + DRAW_BUCKET_COUNT + 1, 0u);
+    for (size_t i = 0; i < meshCount; ++i) {
+        if (!chunkVisible[i]) {
+            continue;
+        }
+        if (!occlusion.isVisible(drawKeys[i])) {
+            ++occludedChunkCount;
+            continue;
+        }
+        
+        const float dx = boundsMinX[i] + halfChunk - camX;
+        const float dy = boundsMinY[i] + halfChunk - camY;
+        const float dz = boundsMinZ[i] + halfChunk - camZ;
+        const float distance = std::sqrt(dx * dx + dy * dy + dz * dz) * invChunkSize;
+        const uint32_t bucket = std::min(static_cast<uint32_t>(distance),
+                                         static_cast<uint32_t>(DRAW_BUCKET_COUNT - 1));
+        visibleSlots.push_back(static_cast<uint32_t>(i));
+        visibleBuckets.push_back(bucket);
+        ++drawBucketOffsets[bucket + 1];
+    }
     
-    // Sort chunks by distance from camera (back-to-front for correct rendering)
-    // Each chunk position is in chunk coordinates, so we need to convert to world space
-    // by multiplying by CHUNK_SIZE and adding half the chunk size to get the center
-    std::sort(sortedChunks.begin(), sortedChunks.end(),
-        [camX, camY, camZ](const auto& a, const auto& b) {
-            // Use CHUNK_SIZE constant from chunk.h
-            constexpr float chunkSize = static_cast<float>(CHUNK_SIZE);
-            constexpr float halfChunk = chunkSize / 2.0f;
-            
-            // Calculate world-space center of each chunk
-            const float aCenterX = std::get<0>(a.first) * chunkSize + halfChunk;
-            const float aCenterY = std::get<1>(a.first) * chunkSize + halfChunk;
-            const float aCenterZ = std::get<2>(a.first) * chunkSize + halfChunk;
-            
-            const float bCenterX = std::get<0>(b.first) * chunkSize + halfChunk;
-            const float bCenterY = std::get<1>(b.first) * chunkSize + halfChunk;
-            const float bCenterZ = std::get<2>(b.first) * chunkSize + halfChunk;
-            
-            // Calculate squared distance from camera (no need for sqrt since we only compare)
-            const float distA = (aCenterX - camX) * (aCenterX - camX) +
-                               (aCenterY - camY) * (aCenterY - camY) +
-                               (aCenterZ - camZ) * (aCenterZ - camZ);
-            
-            const float distB = (bCenterX - camX) * (bCenterX - camX) +
-                               (bCenterY - camY) * (bCenterY - camY) +
-                               (bCenterZ - camZ) * (bCenterZ - camZ);
-            
-            // Sort back-to-front (farther chunks first)
-            return distA > distB;
-        });
-    
-    for (const auto& pair : sortedChunks) {
-        Mesh* mesh = pair.second;
-        if (mesh && mesh->getIndexCount() > 0) {
-            // Bind vertex buffer
-            VkBuffer vertexBuffers[] = {mesh->getVertexBuffer()};
-            VkDeviceSize offsets[] = {0};
-            vkCmdBindVertexBuffers(commandBuffers[currentFrame], 0, 1, vertexBuffers, offsets);
-            
-            // Bind index buffer
-            vkCmdBindIndexBuffer(commandBuffers[currentFrame], mesh->getIndexBuffer(), 0, VK_INDEX_TYPE_UINT32);
-            
-            // Draw the mesh
-            vkCmdDrawIndexed(commandBuffers[currentFrame], mesh->getIndexCount(), 1, 0, 0, 0);
+    for (int bucket = 0; bucket < DRAW_BUCKET_COUNT; ++bucket) {
+        drawBucketOffsets[bucket + 1] += drawBucketOffsets[bucket];
+    }
+    drawnChunkCount = static_cast<uint32_t>(visibleSlots.size());
+    drawOrder.resize(visibleSlots.size());
+    for (size_t i = 0; i < visibleSlots.size(); ++i) {
+        drawOrder[drawBucketOffsets[visibleBuckets[i]]++] = visibleSlots[i];
+    }
+    
+    // Write the indirect draws of the visible chunks into this frame slot's
+    // command and draw data arrays. Each chunk draws only the runs of face
+    // directions that can face the camera (at most three), all sharing the
+    // chunk's draw data entry through firstInstance. Draws are grouped by
+    // geometry page (stably, so each page keeps the front-to-back order)
+    // because a page switch needs a new vertex buffer binding.
+    const uint32_t pageCount = static_cast<uint32_t>(geometryPool->getPageCount());
+    pageDrawOffsets.assign(pageCount + 1, 0u);
+    uint32_t runFirst[3];
+    uint32_t runCount[3];
+    for (uint32_t slot : drawOrder) {
+        const Mesh* mesh = drawMeshes[slot];
+        pageDrawOffsets[mesh->getPage() + 1] += getFaceRuns(mesh, getFrontFacingDirections(slot), runFirst, runCount);
+    }
+    for (uint32_t page = 0; page < pageCount; ++page) {
+        pageDrawOffsets[page + 1] += pageDrawOffsets[page];
+    }
+    
+    const uint32_t drawCount = pageDrawOffsets[pageCount];
+    const uint32_t chunkCount = static_cast<uint32_t>(drawOrder.size());
+    if (indirectDrawBuffer->reserve(currentFrame, std::max(drawCount, chunkCount))) {
+        writeDrawDataDescriptor(currentFrame);
+    }
+    VkDrawIndexedIndirectCommand* commands = indirectDrawBuffer->getCommands(currentFrame);
+    ChunkDrawData* drawData = indirectDrawBuffer->getDrawData(currentFrame);
+    
+    pageDrawCursors.assign(pageDrawOffsets.begin(), pageDrawOffsets.end() - 1);
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        const uint32_t slot = drawOrder[i];
+        const Mesh* mesh = drawMeshes[slot];
+        const int runs = getFaceRuns(mesh, getFrontFacingDirections(slot), runFirst, runCount);
+        for (int run = 0; run < runs; ++run) {
+            VkDrawIndexedIndirectCommand& command = commands[pageDrawCursors[mesh->getPage()]++];
+            command.indexCount = runCount[run] / QUAD_VERTEX_COUNT * QUAD_INDEX_COUNT;
+            command.instanceCount = 1;
+            command.firstIndex = 0;
+            command.vertexOffset = mesh->getVertexOffset() + static_cast<int32_t>(runFirst[run]);
+            command.firstInstance = i;
+        }
+        
+        drawData[i].origin[0] = boundsMinX[slot];
+        drawData[i].origin[1] = boundsMinY[slot];
+        drawData[i].origin[2] = boundsMinZ[slot];
+        drawData[i].origin[3] = 0.0f;
+    }
+    
+    // Bind descriptor sets (uniform buffer and draw data)
+    vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS,
+                           pipeline->getPipelineLayout(), 0, 1, &descriptorSets[currentFrame],
+                           0, nullptr);
+    
+    // Every mesh is a quad list drawn with the shared quad index buffer
+    vkCmdBindIndexBuffer(commandBuffers[currentFrame], geometryPool->getQuadIndexBuffer(), 0, VK_INDEX_TYPE_UINT16);
+    
+    // One indirect call per page (split only beyond the device's draw count
+    // limit); without multi-draw indirect the same commands are issued as
+    // direct draws
+    const VkBuffer commandBuffer = indirectDrawBuffer->getCommandBuffer(currentFrame);
+    const uint32_t maxDrawCount = device->getMaxDrawIndirectCount();
+    for (uint32_t page = 0; page < pageCount; ++page) {
+        const uint32_t first = pageDrawOffsets[page];
+        const uint32_t end = pageDrawOffsets[page + 1];
+        if (first == end) {
+            continue;
+        }
+        
+        VkBuffer vertexBuffers[] = {geometryPool->getVertexBuffer(page)};
+        VkDeviceSize offsets[] = {0};
+        vkCmdBindVertexBuffers(commandBuffers[currentFrame], 0, 1, vertexBuffers, offsets);
+        
+        if (device->supportsMultiDrawIndirect()) {
+            for (uint32_t batch = first; batch < end; batch += maxDrawCount) {
+                vkCmdDrawIndexedIndirect(commandBuffers[currentFrame], commandBuffer,
+                                         sizeof(VkDrawIndexedIndirectCommand) * static_cast<VkDeviceSize>(batch),
+                                         std::min(maxDrawCount, end - batch),
+                                         sizeof(VkDrawIndexedIndirectCommand));
+            }
+        } else {
+            for (uint32_t draw = first; draw < end; ++draw) {
+                vkCmdDrawIndexed(commandBuffers[currentFrame], commands[draw].indexCount, 1,
+                                 0, commands[draw].vertexOffset, commands[draw].firstInstance);
+            }
         }
     }
     
@@ -352,14 +472,48 @@ void Renderer::cleanup() {
         overlayVertexBufferMemory = VK_NULL_HANDLE;
     }
     
+    // Stop mesh workers before releasing the meshes they would replace
+    if (meshBuildQueue) {
+        meshBuildQueue->cleanup();
+        delete meshBuildQueue;
+        meshBuildQueue = nullptr;
+    }
+    completedMeshes.clear();
+    remeshQueue.clear();
+    
     // Clean up all chunk meshes
-    for (auto& pair : chunkMeshes) {
-        if (pair.second) {
-            pair.second->cleanup();
-            delete pair.second;
-        }
+    for (Mesh* mesh : drawMeshes) {
+        mesh->cleanup();
+        delete mesh;
+    }
+    drawMeshes.clear();
+    drawKeys.clear();
+    chunkDrawSlots.clear();
+    occlusion.clear();
+    boundsMinX.clear();
+    boundsMinY.clear();
+    boundsMinZ.clear();
+    boundsMaxX.clear();
+    boundsMaxY.clear();
+    boundsMaxZ.clear();
+    
+    if (geometryPool) {
+        geometryPool->cleanup();
+        delete geometryPool;
+        geometryPool = nullptr;
+    }
+    
+    if (stagingUploader) {
+        stagingUploader->cleanup();
+        delete stagingUploader;
+        stagingUploader = nullptr;
+    }
+    
+    if (indirectDrawBuffer) {
+        indirectDrawBuffer->cleanup();
+        delete indirectDrawBuffer;
+        indirectDrawBuffer = nullptr;
     }
-    chunkMeshes.clear();
     
     if (overlayPipeline) {
         overlayPipeline->cleanup();
@@ -391,6 +545,12 @@ void Renderer::cleanup() {
         framebuffers = nullptr;
     }
     
+    if (depthBuffer) {
+        depthBuffer->cleanup();
+        delete depthBuffer;
+        depthBuffer = nullptr;
+    }
+    
     if (renderPass) {
         renderPass->cleanup();
         delete renderPass;
@@ -458,14 +618,16 @@ void Renderer::createUniformBuffers() {
 }
 
 void Renderer::createDescriptorPool() {
-    VkDescriptorPoolSize poolSize{};
-    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSize.descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+    VkDescriptorPoolSize poolSizes[2]{};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[0].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
     
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.poolSizeCount = 1;
-    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.poolSizeCount = 2;
+    poolInfo.pPoolSizes = poolSizes;
     poolInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
     
     if (vkCreateDescriptorPool(device->getDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
@@ -507,15 +669,37 @@ void Renderer::createDescriptorSets() {
         descriptorWrite.pBufferInfo = &bufferInfo;
         
         vkUpdateDescriptorSets(device->getDevice(), 1, &descriptorWrite, 0, nullptr);
+        
+        writeDrawDataDescriptor(i);
     }
 }
 
+void Renderer::writeDrawDataDescriptor(size_t frameIndex) {
+    // Only called while the frame slot's set is not in use by the GPU
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = indirectDrawBuffer->getDrawDataBuffer(frameIndex);
+    bufferInfo.offset = 0;
+    bufferInfo.range = indirectDrawBuffer->getDrawDataSize(frameIndex);
+    
+    VkWriteDescriptorSet descriptorWrite{};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = descriptorSets[frameIndex];
+    descriptorWrite.dstBinding = 1;
+    descriptorWrite.dstArrayElement = 0;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pBufferInfo = &bufferInfo;
+    
+    vkUpdateDescriptorSets(device->getDevice(), 1, &descriptorWrite, 0, nullptr);
+}
+
 void Renderer::updateUniformBuffer(uint32_t currentImage) {
     float aspectRatio = swapchain->getSwapchainExtent().width / 
                        (float)swapchain->getSwapchainExtent().height;
     
     float mvp[16];
     camera->getMVPMatrix(mvp, aspectRatio);
+    frustum.extractPlanes(mvp);
     
     void* data;
     vkMapMemory(device->getDevice(), uniformBuffersMemory[currentImage], 0, sizeof(mvp), 0, &data);
@@ -539,35 +723,27 @@ uint32_t Renderer::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags pro
 
 void Renderer::logMeshInfo() const {
     // Log information about all chunk meshes
-    if (chunkMeshes.empty()) {
+    if (drawMeshes.empty()) {
         std::cout << "[Mesh] No chunk meshes loaded" << std::endl;
         return;
     }
     
-    std::cout << "[Mesh] Total chunks: " << chunkMeshes.size() << std::endl;
+    std::cout << "[Mesh] Total chunks: " << drawMeshes.size() << std::endl;
     
     // Log info for first chunk mesh as a sample
-    const auto& firstPair = *chunkMeshes.begin();
-    Mesh* mesh = firstPair.second;
-    
-    if (!mesh) {
-        std::cout << "[Mesh] First chunk mesh is null" << std::endl;
-        return;
-    }
+    const Mesh* mesh = drawMeshes[0];
     
     std::cout << "[Mesh] Sample chunk position: (" 
-              << std::get<0>(firstPair.first) << ", "
-              << std::get<1>(firstPair.first) << ", "
-              << std::get<2>(firstPair.first) << ")" << std::endl;
+              << ChunkKeys::getX(drawKeys[0]) << ", "
+              << ChunkKeys::getY(drawKeys[0]) << ", "
+              << ChunkKeys::getZ(drawKeys[0]) << ")" << std::endl;
     std::cout << "[Mesh] Vertex count: " << mesh->getVertexCount() << std::endl;
     std::cout << "[Mesh] Index count: " << mesh->getIndexCount() << std::endl;
     std::cout << "[Mesh] Triangle count: " << (mesh->getIndexCount() / 3) << std::endl;
     std::cout << "[Mesh] Vertex buffer: " << mesh->getVertexBuffer() << std::endl;
-    std::cout << "[Mesh] Index buffer: " << mesh->getIndexBuffer() << std::endl;
+    std::cout << "[Mesh] Index buffer (shared): " << geometryPool->getQuadIndexBuffer() << std::endl;
     std::cout << "[Mesh] Vertex buffer size: " << (mesh->getVertexCount() * sizeof(Vertex)) 
               << " bytes" << std::endl;
-    std::cout << "[Mesh] Index buffer size: " << (mesh->getIndexCount() * sizeof(uint32_t)) 
-              << " bytes" << std::endl;
     
     // Log sample vertices (first 3 and last 3)
     const auto& vertices = mesh->getVertices();
@@ -576,29 +752,27 @@ void Renderer::logMeshInfo() const {
         std::cout << "[Mesh] Sample vertices (first " << sampleCount << "):" << std::endl;
         for (size_t i = 0; i < sampleCount; i++) {
             const Vertex& v = vertices[i];
-            std::cout << "  Vertex " << i << ": pos(" << v.position[0] << ", " 
-                      << v.position[1] << ", " << v.position[2] << ") "
-                      << "normal(" << v.normal[0] << ", " << v.normal[1] << ", " 
-                      << v.normal[2] << ") "
-                      << "uv(" << v.texCoord[0] << ", " << v.texCoord[1] << ")" << std::endl;
+            std::cout << "  Vertex " << i << ": local pos(" << VertexPacking::getX(v) << ", " 
+                      << VertexPacking::getY(v) << ", " << VertexPacking::getZ(v) << ") "
+                      << "face(" << VertexPacking::getFace(v) << ") "
+                      << "uv(" << VertexPacking::getU(v) << ", " << VertexPacking::getV(v) << ")" << std::endl;
         }
         
         if (vertices.size() > 3) {
             std::cout << "[Mesh] Sample vertices (last " << sampleCount << "):" << std::endl;
             for (size_t i = vertices.size() - sampleCount; i < vertices.size(); i++) {
                 const Vertex& v = vertices[i];
-                std::cout << "  Vertex " << i << ": pos(" << v.position[0] << ", " 
-                          << v.position[1] << ", " << v.position[2] << ") "
-                          << "normal(" << v.normal[0] << ", " << v.normal[1] << ", " 
-                          << v.normal[2] << ") "
-                          << "uv(" << v.texCoord[0] << ", " << v.texCoord[1] << ")" << std::endl;
+                std::cout << "  Vertex " << i << ": local pos(" << VertexPacking::getX(v) << ", " 
+                          << VertexPacking::getY(v) << ", " << VertexPacking::getZ(v) << ") "
+                          << "face(" << VertexPacking::getFace(v) << ") "
+                          << "uv(" << VertexPacking::getU(v) << ", " << VertexPacking::getV(v) << ")" << std::endl;
             }
         }
     }
 }
 
 void Renderer::logTransformedMeshInfo() const {
-    if (chunkMeshes.empty() || !camera) {
+    if (drawMeshes.empty() || !camera) {
         std::cout << "[Transformed Mesh] No chunk meshes or camera available" << std::endl;
         return;
     }
@@ -624,13 +798,7 @@ void Renderer::logTransformedMeshInfo() const {
     std::cout << "[Transform] Aspect ratio: " << aspectRatio << std::endl;
     
     // Transform sample vertices from first chunk mesh
-    const auto& firstPair = *chunkMeshes.begin();
-    Mesh* mesh = firstPair.second;
-    
-    if (!mesh) {
-        std::cout << "[Transform] First chunk mesh is null" << std::endl;
-        return;
-    }
+    const Mesh* mesh = drawMeshes[0];
     
     const auto& vertices = mesh->getVertices();
     if (!vertices.empty()) {
@@ -640,10 +808,10 @@ void Renderer::logTransformedMeshInfo() const {
         for (size_t i = 0; i < sampleCount; i++) {
             const Vertex& v = vertices[i];
             
-            // Apply MVP transformation
-            float x = v.position[0];
-            float y = v.position[1];
-            float z = v.position[2];
+            // Place the chunk-local position in the world and apply the MVP
+            float x = boundsMinX[0] + VertexPacking::getX(v);
+            float y = boundsMinY[0] + VertexPacking::getY(v);
+            float z = boundsMinZ[0] + VertexPacking::getZ(v);
             float w = 1.0f;
             
             float tx = mvp[0] * x + mvp[4] * y + mvp[8] * z + mvp[12] * w;
@@ -722,79 +890,265 @@ void Renderer::createOverlayVertexBuffer() {
     vkUnmapMemory(device->getDevice(), overlayVertexBufferMemory);
 }
 
-Mesh* Renderer::createMeshForChunk(Chunk* chunk) {
-    if (!chunk) return nullptr;
-    
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
-    MeshGenerator::generateChunkMesh(*chunk, vertices, indices);
+bool Renderer::createMesh(const std::vector<Vertex>& vertices, const MeshFaceRanges& faceRanges, Mesh*& mesh) {
+    mesh = nullptr;
     
     // Only create mesh if there are vertices
-    if (vertices.empty() || indices.empty()) {
-        return nullptr;
+    if (vertices.empty()) {
+        return true;
     }
     
-    Mesh* mesh = new Mesh(device->getDevice(), device->getPhysicalDevice());
-    mesh->createVertexBuffer(vertices);
-    mesh->createIndexBuffer(indices);
-    
-    return mesh;
+    mesh = new Mesh(geometryPool);
+    if (!mesh->create(vertices, faceRanges)) {
+        delete mesh;
+        mesh = nullptr;
+        return false;
+    }
+    return true;
 }
 
-void Renderer::updateChunkMeshes(ChunkManager* chunkManager) {
-    if (!chunkManager) return;
-    
-    const auto& chunks = chunkManager->getChunks();
+void Renderer::setChunkMesh(ChunkKey key, Mesh* mesh) {
+    const uint32_t* existing = chunkDrawSlots.find(key);
+    if (existing) {
+        const uint32_t slot = *existing;
+        drawMeshes[slot]->cleanup();
+        delete drawMeshes[slot];
+        if (mesh) {
+            drawMeshes[slot] = mesh;  // Bounds are unchanged
+        } else {
+            removeDrawSlot(slot);
+        }
+        return;
+    }
     
-    // Track which chunks should have meshes
-    std::unordered_map<std::tuple<int, int, int>, bool, TupleHash> activeChunks;
+    if (!mesh) {
+        return;
+    }
     
-    // Create or rebuild meshes for chunks
-    for (Chunk* chunk : chunks) {
-        auto key = std::make_tuple(chunk->getPosX(), chunk->getPosY(), chunk->getPosZ());
-        activeChunks[key] = true;
-        
-        // Check if mesh needs to be created or rebuilt
-        auto it = chunkMeshes.find(key);
-        if (it == chunkMeshes.end()) {
-            // Create mesh for new chunk
-            Mesh* mesh = createMeshForChunk(chunk);
-            if (mesh) {
-                chunkMeshes[key] = mesh;
-                chunk->markMeshClean();
-            }
-        } else if (chunk->needsMeshRebuild()) {
-            // Rebuild mesh for dirty chunk
-            if (it->second) {
-                it->second->cleanup();
-                delete it->second;
-            }
-            Mesh* mesh = createMeshForChunk(chunk);
-            if (mesh) {
-                chunkMeshes[key] = mesh;
-            } else {
-                chunkMeshes.erase(it);
+    chunkDrawSlots[key] = static_cast<uint32_t>(drawMeshes.size());
+    drawMeshes.push_back(mesh);
+    drawKeys.push_back(key);
+    
+    const float minX = static_cast<float>(ChunkKeys::getX(key) * CHUNK_SIZE);
+    const float minY = static_cast<float>(ChunkKeys::getY(key) * CHUNK_SIZE);
+    const float minZ = static_cast<float>(ChunkKeys::getZ(key) * CHUNK_SIZE);
+    boundsMinX.push_back(minX);
+    boundsMinY.push_back(minY);
+    boundsMinZ.push_back(minZ);
+    boundsMaxX.push_back(minX + CHUNK_SIZE);
+    boundsMaxY.push_back(minY + CHUNK_SIZE);
+    boundsMaxZ.push_back(minZ + CHUNK_SIZE);
+}
+
+uint32_t Renderer::getFrontFacingDirections(uint32_t slot) const {
+    // A face is only front-facing from the side its normal points to, and
+    // every face of a chunk lies within its bounds: +X faces are hidden
+    // unless the camera is beyond the chunk's minimum X, -X faces unless it
+    // is before the maximum X, and so on. Bits follow ChunkFace order.
+    const float camX = camera->getPositionX();
+    const float camY = camera->getPositionY();
+    const float camZ = camera->getPositionZ();
+    uint32_t directions = 0;
+    if (camX < boundsMaxX[slot]) directions |= 1u << 0;
+    if (camX > boundsMinX[slot]) directions |= 1u << 1;
+    if (camY < boundsMaxY[slot]) directions |= 1u << 2;
+    if (camY > boundsMinY[slot]) directions |= 1u << 3;
+    if (camZ < boundsMaxZ[slot]) directions |= 1u << 4;
+    if (camZ > boundsMinZ[slot]) directions |= 1u << 5;
+    return directions;
+}
+
+int Renderer::getFaceRuns(const Mesh* mesh, uint32_t directions,
+                          uint32_t runFirst[3], uint32_t runCount[3]) {
+    // Directions without quads join either neighbour, so the up to six
+    // ranges collapse into at most three draws (one direction per axis is
+    // always drawn)
+    const MeshFaceRanges& ranges = mesh->getFaceRanges();
+    int runs = 0;
+    bool open = false;
+    for (int face = 0; face < MeshFaceRanges::DIRECTION_COUNT; ++face) {
+        const bool empty = ranges.start[face] == ranges.start[face + 1];
+        if ((directions & (1u << face)) || empty) {
+            if (!open) {
+                runFirst[runs] = ranges.start[face];
+                runCount[runs] = 0;
+                open = true;
             }
-            chunk->markMeshClean();
+            runCount[runs] += ranges.start[face + 1] - ranges.start[face];
+        } else if (open) {
+            open = false;
+            runs += runCount[runs] > 0 ? 1 : 0;
         }
     }
+    if (open) {
+        runs += runCount[runs] > 0 ? 1 : 0;
+    }
+    return runs;
+}
+
+void Renderer::removeDrawSlot(uint32_t slot) {
+    chunkDrawSlots.erase(drawKeys[slot]);
+    
+    // Move the last entry into the hole
+    const uint32_t last = static_cast<uint32_t>(drawMeshes.size() - 1);
+    if (slot != last) {
+        drawMeshes[slot] = drawMeshes[last];
+        drawKeys[slot] = drawKeys[last];
+        boundsMinX[slot] = boundsMinX[last];
+        boundsMinY[slot] = boundsMinY[last];
+        boundsMinZ[slot] = boundsMinZ[last];
+        boundsMaxX[slot] = boundsMaxX[last];
+        boundsMaxY[slot] = boundsMaxY[last];
+        boundsMaxZ[slot] = boundsMaxZ[last];
+        chunkDrawSlots[drawKeys[slot]] = slot;
+    }
     
-    // Remove meshes for chunks that no longer exist
-    std::vector<std::tuple<int, int, int>> meshesToRemove;
-    for (const auto& pair : chunkMeshes) {
-        if (activeChunks.find(pair.first) == activeChunks.end()) {
-            meshesToRemove.push_back(pair.first);
+    drawMeshes.pop_back();
+    drawKeys.pop_back();
+    boundsMinX.pop_back();
+    boundsMinY.pop_back();
+    boundsMinZ.pop_back();
+    boundsMaxX.pop_back();
+    boundsMaxY.pop_back();
+    boundsMaxZ.pop_back();
+}
+
+void Renderer::updateOcclusion() {
+    // The grid spans the streaming window plus one chunk
+    occlusion.update(static_cast<int>(std::floor(camera->getPositionX() / CHUNK_SIZE)),
+                     static_cast<int>(std::floor(camera->getPositionY() / CHUNK_SIZE)),
+                     static_cast<int>(std::floor(camera->getPositionZ() / CHUNK_SIZE)),
+                     streamingConfig.horizontalDistance + 1, streamingConfig.verticalDistance + 1);
+}
+
+void Renderer::updateChunkMeshes(ChunkManager* chunkManager) {
+    if (!chunkManager) return;
+
+    drainChunkEvents(chunkManager);
+
+    // Main-thread time budget shared by mesh submission and upload
+    const std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+    submitMeshJobs(chunkManager, frameStart);
+    uploadCompletedMeshes(chunkManager, frameStart);
+
+    // Submit this frame's copies; render() makes the draw wait for them
+    stagingUploader->flush();
+}
+
+void Renderer::drainChunkEvents(ChunkManager* chunkManager) {
+    // Drop the meshes of unloaded chunks
+    for (ChunkKey key : chunkManager->getUnloadEvents()) {
+        setChunkMesh(key, nullptr);
+        occlusion.setConnectivity(key, nullptr);
+    }
+
+    for (ChunkKey key : chunkManager->getRemeshEvents()) {
+        remeshQueue.push_back({0.0f, key});
+    }
+    chunkManager->clearChunkEvents();
+}
+
+bool Renderer::isOverMeshTimeBudget(std::chrono::steady_clock::time_point frameStart) const {
+    const auto timeBudget = std::chrono::duration<float, std::milli>(streamingConfig.meshTimeBudgetMs);
+    return streamingConfig.meshTimeBudgetMs > 0.0f &&
+           std::chrono::steady_clock::now() - frameStart > timeBudget;
+}
+
+void Renderer::submitMeshJobs(ChunkManager* chunkManager, std::chrono::steady_clock::time_point frameStart) {
+    // Nearest (and in view) first. Priorities are rescored every frame since
+    // the camera may have moved.
+    for (RemeshRequest& request : remeshQueue) {
+        request.priority = chunkManager->getStreamingPriority(ChunkKeys::getX(request.key),
+                                                              ChunkKeys::getY(request.key),
+                                                              ChunkKeys::getZ(request.key));
+    }
+    auto sooner = [](const RemeshRequest& a, const RemeshRequest& b) { return a.priority < b.priority; };
+    const unsigned int meshBudget = streamingConfig.meshJobsPerFrame;
+    if (meshBudget > 0 && meshBudget < remeshQueue.size()) {
+        std::partial_sort(remeshQueue.begin(), remeshQueue.begin() + meshBudget, remeshQueue.end(), sooner);
+    } else {
+        std::sort(remeshQueue.begin(), remeshQueue.end(), sooner);
+    }
+
+    size_t examined = 0;
+    unsigned int submitted = 0;
+    for (; examined < remeshQueue.size(); ++examined) {
+        if ((meshBudget > 0 && submitted >= meshBudget) || isOverMeshTimeBudget(frameStart)) {
+            break;
+        }
+        if (submitMeshJob(chunkManager, remeshQueue[examined].key)) {
+            ++submitted;
         }
     }
-    
-    for (const auto& key : meshesToRemove) {
-        auto it = chunkMeshes.find(key);
-        if (it != chunkMeshes.end()) {
-            if (it->second) {
-                it->second->cleanup();
-                delete it->second;
-            }
-            chunkMeshes.erase(it);
+    remeshQueue.erase(remeshQueue.begin(), remeshQueue.begin() + examined);
+}
+
+bool Renderer::submitMeshJob(ChunkManager* chunkManager, ChunkKey key) {
+    Chunk* chunk = chunkManager->getChunk(ChunkKeys::getX(key), ChunkKeys::getY(key), ChunkKeys::getZ(key));
+
+    // Skip chunks unloaded since the event and duplicate events. Clean
+    // chunks are up to date, already have a job in flight for their
+    // current version, or wait for a missing neighbour (which re-dirties
+    // them when it arrives).
+    if (!chunk || !chunk->needsMeshRebuild()) {
+        return false;
+    }
+    chunk->markMeshClean();
+
+    const PaletteStorage& voxels = chunk->getVoxelStorage();
+    if (voxels.isUniform() && voxels.getUniformType() == VoxelType::AIR) {
+        setChunkMesh(key, nullptr);
+        occlusion.setConnectivity(key, &ChunkConnectivity::ALL);
+        return false;
+    }
+
+    // Border faces can only be culled once all six neighbours are known
+    if (!chunkManager->getNeighbourBorders(chunk->getPosX(), chunk->getPosY(), chunk->getPosZ(),
+                                           neighbourBorders)) {
+        return false;
+    }
+
+    // Buried uniform chunks never have visible geometry: skip the mesher
+    // and GPU allocation entirely
+    if (MeshGenerator::isHidden(voxels, neighbourBorders)) {
+        const ChunkConnectivityMask connectivity = ChunkConnectivity::compute(voxels);
+        setChunkMesh(key, nullptr);
+        occlusion.setConnectivity(key, &connectivity);
+        return false;
+    }
+
+    // The previous mesh (if any) stays visible until the new one arrives
+    meshBuildQueue->submit(*chunk, neighbourBorders);
+    return true;
+}
+
+void Renderer::uploadCompletedMeshes(ChunkManager* chunkManager, std::chrono::steady_clock::time_point frameStart) {
+    // Upload finished meshes whose chunk is still loaded and unchanged. Once
+    // this frame's upload budget or staging space is used up the rest wait
+    // for the next frame.
+    meshBuildQueue->collectResults(completedMeshes);
+    const unsigned int uploadBudget = streamingConfig.uploadsPerFrame;
+    unsigned int uploaded = 0;
+    size_t processed = 0;
+    for (; processed < completedMeshes.size(); ++processed) {
+        if ((uploadBudget > 0 && uploaded >= uploadBudget) || isOverMeshTimeBudget(frameStart)) {
+            break;
+        }
+
+        const MeshBuildResult& result = completedMeshes[processed];
+        Chunk* chunk = chunkManager->getChunk(result.chunkX, result.chunkY, result.chunkZ);
+        if (!chunk || chunk->getVersion() != result.version) {
+            continue;  // Stale: unloaded, or edited while the job was in flight
+        }
+
+        Mesh* mesh = nullptr;
+        if (!createMesh(result.vertices, result.faceRanges, mesh)) {
+            break;
         }
+        const ChunkKey key = ChunkKeys::pack(result.chunkX, result.chunkY, result.chunkZ);
+        setChunkMesh(key, mesh);
+        occlusion.setConnectivity(key, &result.connectivity);
+        ++uploaded;
     }
+    completedMeshes.erase(completedMeshes.begin(), completedMeshes.begin() + processed);
 }
\ No newline at end of file
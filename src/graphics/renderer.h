@@ -4,9 +4,15 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 #include <cstddef>
-#include <unordered_map>
-#include <tuple>
-#include "utils/tuple_hash.h"
+#include <chrono>
+#include <vector>
+#include "utils/flat_hash_map.h"
+#include "world/chunk_connectivity.h"
+#include "world/chunk_occlusion.h"
+#include "world/chunk_key.h"
+#include "world/mesh_build_queue.h"
+#include "world/streaming_config.h"
+#include "frustum.h"
 
 // Forward declarations
 class Window;
@@ -15,12 +21,16 @@ class Device;
 class Swapchain;
 class ImageViews;
 class RenderPass;
+class DepthBuffer;
 class Framebuffers;
 class CommandPool;
 class SyncObjects;
 class Pipeline;
 class OverlayPipeline;
 class Mesh;
+class GeometryPool;
+class StagingUploader;
+class IndirectDrawBuffer;
 class Camera;
 class ChunkManager;
 
@@ -36,8 +46,14 @@ public:
     Camera* getCamera() { return camera; }
     
     // Chunk mesh management
+    void setStreamingConfig(const StreamingConfig& config) { streamingConfig = config; }
     void updateChunkMeshes(ChunkManager* chunkManager);
     
+    // Chunk draw statistics for the last recorded frame
+    uint32_t getDrawnChunkCount() const { return drawnChunkCount; }
+    uint32_t getCulledChunkCount() const { return culledChunkCount; }
+    uint32_t getOccludedChunkCount() const { return occludedChunkCount; }
+    
     // Debug methods
     void logMeshInfo() const;
     void logTransformedMeshInfo() const;
@@ -51,14 +67,39 @@ private:
     Swapchain* swapchain;
     ImageViews* imageViews;
     RenderPass* renderPass;
+    DepthBuffer* depthBuffer;
     Framebuffers* framebuffers;
     CommandPool* commandPool;
     SyncObjects* syncObjects;
     Pipeline* pipeline;
     OverlayPipeline* overlayPipeline;
     
-    // Dynamic chunk meshes
-    std::unordered_map<std::tuple<int, int, int>, Mesh*, TupleHash> chunkMeshes;
+    // Persistent draw list: one entry per chunk with geometry, stored as
+    // flat parallel arrays (meshes, keys and world-space bounds). Entries
+    // change only when a chunk's mesh is uploaded or its chunk unloads;
+    // removal moves the last entry into the hole, so nothing is rebuilt
+    // per frame.
+    FlatHashMap<uint32_t> chunkDrawSlots;
+    std::vector<Mesh*> drawMeshes;
+    std::vector<ChunkKey> drawKeys;
+    GeometryPool* geometryPool;
+    StagingUploader* stagingUploader;
+    IndirectDrawBuffer* indirectDrawBuffer;
+    
+    // Background mesh building; results are uploaded in updateChunkMeshes()
+    // (those that did not fit into this frame's staging space wait here)
+    MeshBuildQueue* meshBuildQueue;
+    std::vector<MeshBuildResult> completedMeshes;
+    
+    // Chunks waiting for a mesh job, most urgent first after sorting; the
+    // per-frame meshing budget leaves the rest for later frames
+    struct RemeshRequest {
+        float priority;
+        ChunkKey key;
+    };
+    std::vector<RemeshRequest> remeshQueue;
+    StreamingConfig streamingConfig;
+    ChunkBorders neighbourBorders;  // Scratch space for gathering neighbour layers
     
     // Overlay square mesh
     VkBuffer overlayVertexBuffer;
@@ -67,6 +108,34 @@ private:
     // Camera
     Camera* camera;
     
+    // Frustum culling: planes from this frame's MVP, tested against the
+    // draw list bounds (separate coordinate arrays for batched tests)
+    Frustum frustum;
+    std::vector<float> boundsMinX, boundsMinY, boundsMinZ;
+    std::vector<float> boundsMaxX, boundsMaxY, boundsMaxZ;
+    std::vector<uint8_t> chunkVisible;
+    
+    // Front-to-back draw order: visible chunks bucketed by distance in
+    // chunks (the last bucket collects everything further away). Entries
+    // are draw list slots, which also give each draw its chunk origin.
+    static const int DRAW_BUCKET_COUNT = 64;
+    std::vector<uint32_t> visibleSlots;
+    std::vector<uint32_t> visibleBuckets;
+    std::vector<uint32_t> drawOrder;
+    
+    // Indirect draws grouped by geometry page: page p owns draws
+    // [pageDrawOffsets[p], pageDrawOffsets[p + 1])
+    std::vector<uint32_t> pageDrawOffsets;
+    std::vector<uint32_t> pageDrawCursors;
+    uint32_t drawBucketOffsets[DRAW_BUCKET_COUNT + 1];
+    uint32_t drawnChunkCount;
+    uint32_t culledChunkCount;
+    uint32_t occludedChunkCount;
+    
+    // Cave occlusion: connectivity of every meshed chunk, and the chunks
+    // the camera's chunk can see through it
+    ChunkOcclusion occlusion;
+    
     // Uniform buffers for MVP matrix
     VkBuffer* uniformBuffers;
     VkDeviceMemory* uniformBuffersMemory;
@@ -78,19 +147,51 @@ private:
     
     // Rendering state
     size_t currentFrame;
+    std::vector<VkSemaphore> submitWaitSemaphores;
+    std::vector<VkPipelineStageFlags> submitWaitStages;
     double startTime;
     static const size_t MAX_FRAMES_IN_FLIGHT = 2;
     
     void createUniformBuffers();
     void createDescriptorPool();
     void createDescriptorSets();
+    void writeDrawDataDescriptor(size_t frameIndex);
     void updateUniformBuffer(uint32_t currentImage);
     void recordCommandBuffer(size_t imageIndex);
     uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
     void createOverlayVertexBuffer();
     
-    // Helper to create mesh for a chunk
-    Mesh* createMeshForChunk(class Chunk* chunk);
+    // Upload CPU mesh data (mesh is nullptr for empty meshes). Returns false
+    // if the upload has to wait for a later frame.
+    bool createMesh(const std::vector<Vertex>& vertices, const MeshFaceRanges& faceRanges, Mesh*& mesh);
+    
+    // Steps of updateChunkMeshes(): move the chunk manager's events into
+    // the mesh state and remesh queue, start mesh jobs for the most urgent
+    // chunks, and upload finished meshes. Job submission and upload stop
+    // once the frame's job/upload counts or shared time budget are used up.
+    void drainChunkEvents(ChunkManager* chunkManager);
+    void submitMeshJobs(ChunkManager* chunkManager, std::chrono::steady_clock::time_point frameStart);
+    void uploadCompletedMeshes(ChunkManager* chunkManager, std::chrono::steady_clock::time_point frameStart);
+    bool isOverMeshTimeBudget(std::chrono::steady_clock::time_point frameStart) const;
+    
+    // Handle one remesh request; returns true if a mesh job was started
+    bool submitMeshJob(ChunkManager* chunkManager, ChunkKey key);
+    
+    // Replace (or with nullptr, remove) the mesh stored for a chunk
+    void setChunkMesh(ChunkKey key, Mesh* mesh);
+    void removeDrawSlot(uint32_t slot);
+    
+    // Redo the occlusion search from the camera's chunk if needed
+    void updateOcclusion();
+    
+    // Bit f is set if faces in direction f (ChunkFace order) of the chunk in
+    // draw slot `slot` can face the camera
+    uint32_t getFrontFacingDirections(uint32_t slot) const;
+    
+    // Split a mesh's drawn directions into contiguous vertex ranges (relative
+    // to the mesh). Returns the number of ranges, at most three.
+    static int getFaceRuns(const Mesh* mesh, uint32_t directions,
+                           uint32_t runFirst[3], uint32_t runCount[3]);
 };
 
 #endif // RENDERER_H
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "staging_uploader.h"
+#include <stdexcept>
+#include <cstring>
+
+StagingUploader::StagingUploader(VkDevice device, VkPhysicalDevice physicalDevice,
+                                 VkQueue transferQueue, uint32_t transferQueueFamily)
+    : device(device), physicalDevice(physicalDevice),
+      transferQueue(transferQueue), transferQueueFamily(transferQueueFamily),
+      commandPool(VK_NULL_HANDLE), stagingSize(0), recordingBatch(-1) {
+}
+
+StagingUploader::~StagingUploader() {
+    cleanup();
+}
+
+void StagingUploader::init(size_t framesInFlight, VkDeviceSize stagingSize) {
+    this->stagingSize = stagingSize;
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT |
+                     VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = transferQueueFamily;
+
+    if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create transfer command pool!");
+    }
+
+    // One batch per frame in flight plus one being filled
+    batches.resize(framesInFlight + 1);
+    for (Batch& batch : batches) {
+        createBatch(batch);
+    }
+    recordingBatch = -1;
+}
+
+void StagingUploader::cleanup() {
+    for (Batch& batch : batches) {
+        if (batch.mapped) {
+            vkUnmapMemory(device, batch.stagingMemory);
+        }
+        vkDestroyBuffer(device, batch.stagingBuffer, nullptr);
+        vkFreeMemory(device, batch.stagingMemory, nullptr);
+        vkDestroyFence(device, batch.fence, nullptr);
+        vkDestroySemaphore(device, batch.semaphore, nullptr);
+    }
+    batches.clear();
+    recordingBatch = -1;
+
+    // Frees the command buffers as well
+    if (commandPool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(device, commandPool, nullptr);
+        commandPool = VK_NULL_HANDLE;
+    }
+}
+
+bool StagingUploader::reserve(VkDeviceSize size) {
+    if (size > stagingSize) {
+        throw std::runtime_error("Upload is larger than the staging buffer!");
+    }
+
+    if (recordingBatch < 0) {
+        for (size_t i = 0; i < batches.size(); ++i) {
+            if (batches[i].state == BATCH_FREE) {
+                batches[i].state = BATCH_RECORDING;
+                batches[i].used = 0;
+                recordingBatch = static_cast<int>(i);
+                break;
+            }
+        }
+        if (recordingBatch < 0) {
+            return false;  // All batches still in flight
+        }
+    }
+
+    return batches[recordingBatch].used + size <= stagingSize;
+}
+
+void StagingUploader::stage(const void* data, VkDeviceSize size, VkBuffer dst, VkDeviceSize dstOffset) {
+    Batch& batch = batches[recordingBatch];
+
+    std::memcpy(static_cast<char*>(batch.mapped) + batch.used, data, static_cast<size_t>(size));
+
+    PendingCopy copy;
+    copy.dst = dst;
+    copy.region.srcOffset = batch.used;
+    copy.region.dstOffset = dstOffset;
+    copy.region.size = size;
+    batch.copies.push_back(copy);
+
+    // Keep source offsets 16-byte aligned
+    batch.used = (batch.used + size + 15) & ~VkDeviceSize(15);
+}
+
+void StagingUploader::flush() {
+    if (recordingBatch < 0) {
+        return;
+    }
+    Batch& batch = batches[recordingBatch];
+    recordingBatch = -1;
+
+    if (batch.copies.empty()) {
+        batch.state = BATCH_FREE;
+        return;
+    }
+
+    vkResetCommandBuffer(batch.commandBuffer, 0);
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (vkBeginCommandBuffer(batch.commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to begin recording transfer command buffer!");
+    }
+
+    for (const PendingCopy& copy : batch.copies) {
+        vkCmdCopyBuffer(batch.commandBuffer, batch.stagingBuffer, copy.dst, 1, &copy.region);
+    }
+
+    if (vkEndCommandBuffer(batch.commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to record transfer command buffer!");
+    }
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &batch.commandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &batch.semaphore;
+
+    vkResetFences(device, 1, &batch.fence);
+    if (vkQueueSubmit(transferQueue, 1, &submitInfo, batch.fence) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to submit transfer command buffer!");
+    }
+
+    batch.copies.clear();
+    batch.state = BATCH_SUBMITTED;
+}
+
+void StagingUploader::consumeWaitSemaphores(size_t frameIndex, std::vector<VkSemaphore>& semaphores) {
+    for (Batch& batch : batches) {
+        if (batch.state == BATCH_SUBMITTED) {
+            semaphores.push_back(batch.semaphore);
+            batch.state = BATCH_CONSUMED;
+            batch.consumedFrame = frameIndex;
+        }
+    }
+}
+
+void StagingUploader::beginFrame(size_t frameIndex) {
+    // The graphics frame that waited on these batches has finished, so their
+    // semaphores are unsignalled again; the fence check never blocks
+    for (Batch& batch : batches) {
+        if (batch.state == BATCH_CONSUMED && batch.consumedFrame == frameIndex &&
+            vkGetFenceStatus(device, batch.fence) == VK_SUCCESS) {
+            batch.state = BATCH_FREE;
+        }
+    }
+}
+
+void StagingUploader::createBatch(Batch& batch) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = stagingSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &batch.stagingBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create staging buffer!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, batch.stagingBuffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &batch.stagingMemory) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate staging buffer memory!");
+    }
+
+    if (vkBindBufferMemory(device, batch.stagingBuffer, batch.stagingMemory, 0) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to bind staging buffer memory!");
+    }
+
+    // Stays mapped for the batch's lifetime
+    if (vkMapMemory(device, batch.stagingMemory, 0, stagingSize, 0, &batch.mapped) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to map staging buffer memory!");
+    }
+    batch.used = 0;
+
+    VkCommandBufferAllocateInfo cmdInfo{};
+    cmdInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cmdInfo.commandPool = commandPool;
+    cmdInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmdInfo.commandBufferCount = 1;
+
+    if (vkAllocateCommandBuffers(device, &cmdInfo, &batch.commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate transfer command buffer!");
+    }
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    if (vkCreateFence(device, &fenceInfo, nullptr, &batch.fence) != VK_SUCCESS ||
+        vkCreateSemaphore(device, &semaphoreInfo, nullptr, &batch.semaphore) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create transfer synchronization objects!");
+    }
+
+    batch.state = BATCH_FREE;
+    batch.consumedFrame = 0;
+}
+
+uint32_t StagingUploader::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1 << i)) &&
+            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("Failed to find suitable memory type!");
+}
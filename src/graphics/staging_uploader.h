@@ -0,0 +1,95 @@
+#ifndef STAGING_UPLOADER_H
+#define STAGING_UPLOADER_H
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Copies data into device-local buffers through host-visible staging memory
+//
+// Work is grouped into batches, each owning a persistently mapped staging
+// buffer, a command buffer, a fence and a semaphore. stage() writes into the
+// current batch; flush() records the copies and submits them on the transfer
+// queue, signalling the batch's semaphore and fence. The next graphics
+// submission waits on that semaphore (see consumeWaitSemaphores()), so
+// geometry uploaded in a frame can be drawn in the same frame without the
+// CPU ever waiting on the copy.
+//
+// A batch is recycled once its fence has signalled and the graphics frame
+// that waited on its semaphore has completed (reported via beginFrame()).
+// When no batch is free, or the current one is full, reserve() fails and
+// the caller retries next frame, so uploads are also bounded per frame.
+class StagingUploader {
+public:
+    static const VkDeviceSize DEFAULT_STAGING_SIZE = 8 * 1024 * 1024;
+
+    StagingUploader(VkDevice device, VkPhysicalDevice physicalDevice,
+                    VkQueue transferQueue, uint32_t transferQueueFamily);
+    ~StagingUploader();
+
+    void init(size_t framesInFlight, VkDeviceSize stagingSize = DEFAULT_STAGING_SIZE);
+    void cleanup();
+
+    // Make room for `size` bytes of staged data in the current batch.
+    // Returns false if the data has to wait for a later frame.
+    bool reserve(VkDeviceSize size);
+
+    // Queue a copy of `size` bytes into `dst` at byte offset `dstOffset`.
+    // The space must have been reserved.
+    void stage(const void* data, VkDeviceSize size, VkBuffer dst, VkDeviceSize dstOffset);
+
+    // Submit all copies staged since the last flush
+    void flush();
+
+    // Hand out the semaphores of submitted batches that no graphics
+    // submission has waited on yet. The caller must wait on all of them in
+    // the submission it makes for frame slot `frameIndex`.
+    void consumeWaitSemaphores(size_t frameIndex, std::vector<VkSemaphore>& semaphores);
+
+    // Call after waiting on the fence of frame slot `frameIndex`
+    void beginFrame(size_t frameIndex);
+
+private:
+    enum BatchState {
+        BATCH_FREE,
+        BATCH_RECORDING,   // Receiving stage() calls
+        BATCH_SUBMITTED,   // On the transfer queue, semaphore not yet waited on
+        BATCH_CONSUMED     // Semaphore waited on by a graphics frame in flight
+    };
+
+    struct PendingCopy {
+        VkBuffer dst;
+        VkBufferCopy region;
+    };
+
+    struct Batch {
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingMemory;
+        void* mapped;
+        VkDeviceSize used;
+        std::vector<PendingCopy> copies;
+
+        VkCommandBuffer commandBuffer;
+        VkFence fence;
+        VkSemaphore semaphore;
+
+        BatchState state;
+        size_t consumedFrame;
+    };
+
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    VkQueue transferQueue;
+    uint32_t transferQueueFamily;
+    VkCommandPool commandPool;
+    VkDeviceSize stagingSize;
+
+    std::vector<Batch> batches;
+    int recordingBatch;  // Index of the batch in BATCH_RECORDING, or -1
+
+    void createBatch(Batch& batch);
+    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+};
+
+#endif // STAGING_UPLOADER_H
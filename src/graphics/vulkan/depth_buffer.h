@@ -0,0 +1,38 @@
+#ifndef DEPTH_BUFFER_H
+#define DEPTH_BUFFER_H
+
+#include <vulkan/vulkan.h>
+
+// Depth attachment shared by all swapchain framebuffers
+//
+// The renderer uses reverse-Z (near plane at depth 1, far plane at 0, cleared
+// to 0 and tested with GREATER), so a floating-point format is preferred:
+// its precision is concentrated near 0, which reverse-Z maps to the far
+// distances that need it most.
+class DepthBuffer {
+public:
+    DepthBuffer(VkDevice device, VkPhysicalDevice physicalDevice);
+    ~DepthBuffer();
+
+    void createDepthResources(VkExtent2D extent);
+    void cleanup();
+
+    VkFormat getFormat() const { return format; }
+    VkImageView getImageView() const { return imageView; }
+
+    // Pick the best supported depth format without creating anything, so the
+    // render pass can be created before the image
+    static VkFormat findDepthFormat(VkPhysicalDevice physicalDevice);
+
+private:
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    VkFormat format;
+    VkImage image;
+    VkDeviceMemory imageMemory;
+    VkImageView imageView;
+
+    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+};
+
+#endif // DEPTH_BUFFER_H
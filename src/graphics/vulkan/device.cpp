@@ -11,7 +11,9 @@
 #endif
 
 Device::Device() : device(VK_NULL_HANDLE), physicalDevice(VK_NULL_HANDLE), 
-                   graphicsQueue(VK_NULL_HANDLE), presentQueue(VK_NULL_HANDLE) {
+                   graphicsQueue(VK_NULL_HANDLE), presentQueue(VK_NULL_HANDLE),
+                   transferQueue(VK_NULL_HANDLE), graphicsQueueFamily(0), transferQueueFamily(0),
+                   multiDrawIndirect(false), maxDrawIndirectCount(1) {
 }
 
 Device::~Device() {
@@ -70,9 +72,13 @@ void Device::createLogicalDevice(VkSurfaceKHR surface) {
     if (graphicsFamily < 0 || presentFamily < 0) {
         throw std::runtime_error("Failed to find suitable queue families!");
     }
+    
+    int transferFamily = findTransferQueueFamily(queueFamilies, graphicsFamily);
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-    std::set<uint32_t> uniqueQueueFamilies = {static_cast<uint32_t>(graphicsFamily), static_cast<uint32_t>(presentFamily)};
+    std::set<uint32_t> uniqueQueueFamilies = {static_cast<uint32_t>(graphicsFamily),
+                                              static_cast<uint32_t>(presentFamily),
+                                              static_cast<uint32_t>(transferFamily)};
 
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -84,7 +90,21 @@ void Device::createLogicalDevice(VkSurfaceKHR surface) {
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
+    // Indirect chunk drawing needs several draws per call and a non-zero
+    // firstInstance in the draw commands; without either the renderer falls
+    // back to one direct draw per chunk
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
     VkPhysicalDeviceFeatures deviceFeatures{};
+    multiDrawIndirect = supportedFeatures.multiDrawIndirect && supportedFeatures.drawIndirectFirstInstance;
+    if (multiDrawIndirect) {
+        deviceFeatures.multiDrawIndirect = VK_TRUE;
+        deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
+        maxDrawIndirectCount = properties.limits.maxDrawIndirectCount;
+    }
 
     // Required device extensions
     std::vector<const char*> deviceExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
@@ -107,6 +127,36 @@ void Device::createLogicalDevice(VkSurfaceKHR surface) {
 
     vkGetDeviceQueue(device, graphicsFamily, 0, &graphicsQueue);
     vkGetDeviceQueue(device, presentFamily, 0, &presentQueue);
+    vkGetDeviceQueue(device, transferFamily, 0, &transferQueue);
+    
+    graphicsQueueFamily = static_cast<uint32_t>(graphicsFamily);
+    transferQueueFamily = static_cast<uint32_t>(transferFamily);
+    if (hasDedicatedTransferQueue()) {
+        std::cout << "Using dedicated transfer queue family " << transferQueueFamily << std::endl;
+    }
+    if (!multiDrawIndirect) {
+        std::cout << "Multi-draw indirect not supported, drawing chunks one by one" << std::endl;
+    }
+}
+
+int Device::findTransferQueueFamily(const std::vector<VkQueueFamilyProperties>& families, int graphicsFamily) const {
+    // Prefer a transfer-only family (usually backed by a DMA engine), then
+    // any non-graphics family that supports transfers
+    int fallback = -1;
+    for (size_t i = 0; i < families.size(); i++) {
+        const VkQueueFlags flags = families[i].queueFlags;
+        if (!(flags & VK_QUEUE_TRANSFER_BIT) || (flags & VK_QUEUE_GRAPHICS_BIT)) {
+            continue;
+        }
+        if (!(flags & VK_QUEUE_COMPUTE_BIT)) {
+            return static_cast<int>(i);
+        }
+        if (fallback < 0) {
+            fallback = static_cast<int>(i);
+        }
+    }
+    // Graphics queues always support transfers
+    return fallback >= 0 ? fallback : graphicsFamily;
 }
 
 bool Device::deviceSupportsExtensions(VkPhysicalDevice dev) const {
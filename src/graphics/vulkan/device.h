@@ -2,6 +2,8 @@
 #define DEVICE_H
 
 #include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
 
 class Device {
 public:
@@ -16,16 +18,33 @@ public:
     VkPhysicalDevice getPhysicalDevice() const { return physicalDevice; }
     VkQueue getGraphicsQueue() const { return graphicsQueue; }
     VkQueue getPresentQueue() const { return presentQueue; }
+    
+    // Transfer queue for buffer uploads. This is a dedicated transfer-only
+    // family when the device exposes one, otherwise the graphics queue.
+    VkQueue getTransferQueue() const { return transferQueue; }
+    uint32_t getGraphicsQueueFamily() const { return graphicsQueueFamily; }
+    uint32_t getTransferQueueFamily() const { return transferQueueFamily; }
+    bool hasDedicatedTransferQueue() const { return transferQueueFamily != graphicsQueueFamily; }
+    
+    // True if multiDrawIndirect and drawIndirectFirstInstance are enabled
+    bool supportsMultiDrawIndirect() const { return multiDrawIndirect; }
+    uint32_t getMaxDrawIndirectCount() const { return maxDrawIndirectCount; }
 
 private:
     VkDevice device;
     VkPhysicalDevice physicalDevice;
     VkQueue graphicsQueue;
     VkQueue presentQueue;
+    VkQueue transferQueue;
+    uint32_t graphicsQueueFamily;
+    uint32_t transferQueueFamily;
+    bool multiDrawIndirect;
+    uint32_t maxDrawIndirectCount;
 
     bool deviceSupportsExtensions(VkPhysicalDevice dev) const;
     bool findQueueFamilies(VkPhysicalDevice dev, VkSurfaceKHR surface, int& gfx, int& present) const;
     bool swapchainAdequate(VkPhysicalDevice dev, VkSurfaceKHR surface) const;
+    int findTransferQueueFamily(const std::vector<VkQueueFamilyProperties>& families, int graphicsFamily) const;
 };
 
 #endif // DEVICE_H
\ No newline at end of file
@@ -10,17 +10,20 @@ Framebuffers::~Framebuffers() {
 }
 
 void Framebuffers::createFramebuffers(const std::vector<VkImageView>& imageViews, 
+                                     VkImageView depthImageView,
                                      VkRenderPass renderPass,
                                      VkExtent2D extent) {
     framebuffers.resize(imageViews.size());
 
     for (size_t i = 0; i < imageViews.size(); i++) {
-        VkImageView attachments[] = { imageViews[i] };
+        // Frames in flight are serialised by the render pass dependency, so
+        // every framebuffer can share the same depth image
+        VkImageView attachments[] = { imageViews[i], depthImageView };
 
         VkFramebufferCreateInfo framebufferInfo{};
         framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         framebufferInfo.renderPass = renderPass;
-        framebufferInfo.attachmentCount = 1;
+        framebufferInfo.attachmentCount = 2;
         framebufferInfo.pAttachments = attachments;
         framebufferInfo.width = extent.width;
         framebufferInfo.height = extent.height;
@@ -10,6 +10,7 @@ public:
     ~Framebuffers();
 
     void createFramebuffers(const std::vector<VkImageView>& imageViews, 
+                           VkImageView depthImageView,
                            VkRenderPass renderPass,
                            VkExtent2D extent);
     void cleanup();
@@ -8,7 +8,7 @@ public:
     RenderPass(VkDevice device);
     ~RenderPass();
 
-    void createRenderPass(VkFormat swapchainImageFormat);
+    void createRenderPass(VkFormat swapchainImageFormat, VkFormat depthFormat);
     void cleanup();
 
     VkRenderPass getRenderPass() const { return renderPass; }
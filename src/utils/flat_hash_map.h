@@ -0,0 +1,163 @@
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing hash map from 64-bit integer keys (e.g. ChunkKey) to
+// small copyable values
+//
+// Entries live in one flat slot array (power-of-two size, at most half
+// full) probed linearly, so a lookup usually touches a single cache line.
+// Keys are scrambled with the SplitMix64 finaliser, which spreads
+// neighbouring coordinates over the whole table. Erasing shifts the
+// following entries back instead of leaving tombstones, so lookups never
+// degrade as chunks stream in and out.
+//
+// The key ~0 is reserved. Pointers returned by find() and operator[] are
+// invalidated by any insertion or erase, and the map must not be modified
+// inside forEach().
+template <typename Value>
+class FlatHashMap {
+public:
+    static constexpr uint64_t EMPTY_KEY = ~uint64_t(0);
+
+    FlatHashMap() : count(0), mask(0) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Value* find(uint64_t key) {
+        if (count == 0) {
+            return nullptr;
+        }
+        for (size_t i = slotFor(key); ; i = (i + 1) & mask) {
+            if (slots[i].key == key) {
+                return &slots[i].value;
+            }
+            if (slots[i].key == EMPTY_KEY) {
+                return nullptr;
+            }
+        }
+    }
+
+    const Value* find(uint64_t key) const {
+        return const_cast<FlatHashMap*>(this)->find(key);
+    }
+
+    bool contains(uint64_t key) const { return find(key) != nullptr; }
+
+    // Value for `key`, inserting a value-initialised one if missing
+    Value& operator[](uint64_t key) {
+        if ((count + 1) * 2 > slots.size()) {
+            rehash(slots.empty() ? 16 : slots.size() * 2);
+        }
+        size_t i = slotFor(key);
+        for (; slots[i].key != EMPTY_KEY; i = (i + 1) & mask) {
+            if (slots[i].key == key) {
+                return slots[i].value;
+            }
+        }
+        slots[i].key = key;
+        slots[i].value = Value();
+        ++count;
+        return slots[i].value;
+    }
+
+    bool erase(uint64_t key) {
+        if (count == 0) {
+            return false;
+        }
+        size_t hole = slotFor(key);
+        for (; slots[hole].key != key; hole = (hole + 1) & mask) {
+            if (slots[hole].key == EMPTY_KEY) {
+                return false;
+            }
+        }
+
+        // Move back every following entry of the probe run that may live in
+        // the hole (its home slot is not between the hole and itself)
+        for (size_t i = (hole + 1) & mask; slots[i].key != EMPTY_KEY; i = (i + 1) & mask) {
+            const size_t home = slotFor(slots[i].key);
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                slots[hole] = slots[i];
+                hole = i;
+            }
+        }
+        slots[hole].key = EMPTY_KEY;
+        slots[hole].value = Value();
+        --count;
+        return true;
+    }
+
+    // Remove all entries, keeping the allocated slots
+    void clear() {
+        for (Slot& slot : slots) {
+            slot.key = EMPTY_KEY;
+            slot.value = Value();
+        }
+        count = 0;
+    }
+
+    // Make room for `n` entries without rehashing
+    void reserve(size_t n) {
+        size_t capacity = 16;
+        while (capacity < n * 2) {
+            capacity *= 2;
+        }
+        if (capacity > slots.size()) {
+            rehash(capacity);
+        }
+    }
+
+    // Call func(key, value) for every entry, in no particular order
+    template <typename Func>
+    void forEach(Func func) const {
+        for (const Slot& slot : slots) {
+            if (slot.key != EMPTY_KEY) {
+                func(slot.key, slot.value);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        uint64_t key;
+        Value value;
+    };
+
+    std::vector<Slot> slots;
+    size_t count;
+    size_t mask;
+
+    static uint64_t mix(uint64_t key) {
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        key ^= key >> 31;
+        return key;
+    }
+
+    size_t slotFor(uint64_t key) const { return static_cast<size_t>(mix(key)) & mask; }
+
+    void rehash(size_t capacity) {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.assign(capacity, Slot{EMPTY_KEY, Value()});
+        mask = capacity - 1;
+
+        for (const Slot& slot : old) {
+            if (slot.key != EMPTY_KEY) {
+                size_t i = slotFor(slot.key);
+                while (slots[i].key != EMPTY_KEY) {
+                    i = (i + 1) & mask;
+                }
+                slots[i] = slot;
+            }
+        }
+    }
+};
+
+#endif // FLAT_HASH_MAP_H
@@ -0,0 +1,62 @@
+#include "range_allocator.h"
+#include <iterator>
+
+RangeAllocator::RangeAllocator() : capacity(0), freeCount(0) {
+}
+
+void RangeAllocator::init(uint32_t capacity) {
+    this->capacity = capacity;
+    freeCount = capacity;
+    freeBlocks.clear();
+    if (capacity > 0) {
+        freeBlocks[0] = capacity;
+    }
+}
+
+bool RangeAllocator::allocate(uint32_t count, uint32_t& offset) {
+    if (count == 0 || count > freeCount) {
+        return false;
+    }
+
+    for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it) {
+        if (it->second < count) {
+            continue;
+        }
+
+        offset = it->first;
+        const uint32_t remaining = it->second - count;
+        freeBlocks.erase(it);
+        if (remaining > 0) {
+            freeBlocks[offset + count] = remaining;
+        }
+        freeCount -= count;
+        return true;
+    }
+    return false;
+}
+
+void RangeAllocator::free(uint32_t offset, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+    freeCount += count;
+
+    // Merge with the following block
+    auto next = freeBlocks.find(offset + count);
+    if (next != freeBlocks.end()) {
+        count += next->second;
+        freeBlocks.erase(next);
+    }
+
+    // Merge with the preceding block
+    auto it = freeBlocks.lower_bound(offset);
+    if (it != freeBlocks.begin()) {
+        auto prev = std::prev(it);
+        if (prev->first + prev->second == offset) {
+            prev->second += count;
+            return;
+        }
+    }
+
+    freeBlocks[offset] = count;
+}
@@ -0,0 +1,34 @@
+#ifndef RANGE_ALLOCATOR_H
+#define RANGE_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+// First-fit free-list allocator over an abstract range [0, capacity)
+//
+// Works in caller-defined units (e.g. vertices or indices) and never touches
+// memory itself. Adjacent free blocks are merged when a range is released.
+class RangeAllocator {
+public:
+    RangeAllocator();
+
+    void init(uint32_t capacity);
+
+    // Reserve `count` units. Returns false if no free block is large enough.
+    bool allocate(uint32_t count, uint32_t& offset);
+
+    // Return a range previously obtained from allocate()
+    void free(uint32_t offset, uint32_t count);
+
+    uint32_t getCapacity() const { return capacity; }
+    uint32_t getFreeCount() const { return freeCount; }
+    size_t getFreeBlockCount() const { return freeBlocks.size(); }
+
+private:
+    uint32_t capacity;
+    uint32_t freeCount;
+    std::map<uint32_t, uint32_t> freeBlocks;  // offset -> size, sorted by offset
+};
+
+#endif // RANGE_ALLOCATOR_H
@@ -0,0 +1,68 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool() : stopping(false) {
+}
+
+ThreadPool::~ThreadPool() {
+    cleanup();
+}
+
+void ThreadPool::init(unsigned int workerCount) {
+    if (workerCount == 0) {
+        workerCount = std::thread::hardware_concurrency();
+    }
+    if (workerCount == 0) {
+        workerCount = 1;  // hardware_concurrency() may be unknown
+    }
+
+    stopping = false;
+    workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+void ThreadPool::cleanup() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    condition.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers.clear();
+}
+
+void ThreadPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    condition.notify_one();
+}
+
+size_t ThreadPool::getQueuedJobCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size();
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Fixed-size pool of worker threads executing jobs in FIFO order.
+// Jobs must not touch main-thread state directly; they hand results back
+// through a queue owned by the submitter.
+class ThreadPool {
+public:
+    ThreadPool();
+    ~ThreadPool();
+
+    // Start the workers. A count of 0 uses std::thread::hardware_concurrency().
+    void init(unsigned int workerCount = 0);
+
+    // Stop the workers. Jobs still queued are discarded; running jobs finish.
+    void cleanup();
+
+    void submit(std::function<void()> job);
+
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+    size_t getQueuedJobCount() const;
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+
+    void workerLoop();
+};
+
+#endif // THREAD_POOL_H
@@ -1,12 +1,16 @@
 #include "chunk.h"
-#include "noise.h"
+#include "heightmap_cache.h"
 #include "terrain_config.h"
-#include <vector>
-#include <cmath>
+#include <atomic>
+#include <cstring>
 
-Chunk::Chunk(int x, int y, int z) : posX(x), posY(y), posZ(z), isLoaded(false), meshDirty(false) {
-    // Initialize voxel data
-    voxels.resize(CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE);
+// Global chunk version counter (chunks are created on the main thread but
+// versions may be bumped from any thread)
+static std::atomic<uint64_t> nextChunkVersion(1);
+
+Chunk::Chunk(int x, int y, int z)
+    : posX(x), posY(y), posZ(z), voxels(CHUNK_VOLUME), isLoaded(false), meshDirty(false),
+      version(nextChunkVersion.fetch_add(1, std::memory_order_relaxed)) {
 }
 
 Chunk::~Chunk() {
@@ -14,14 +18,30 @@ Chunk::~Chunk() {
 }
 
 void Chunk::load() {
+    if (!isLoaded) {
+        ColumnHeights columns;
+        HeightmapCache::computeColumn(posX, posZ, columns);
+        load(columns);
+    }
+}
+
+void Chunk::load(const ColumnHeights& columns) {
     if (!isLoaded) {
         // Load voxel data from disk or generate procedurally
-        generateVoxels();
+        generateVoxels(columns);
         isLoaded = true;
         meshDirty = true;  // Mark mesh as needing rebuild after loading
     }
 }
 
+void Chunk::loadUniform(uint8_t type) {
+    if (!isLoaded) {
+        voxels.fill(type);
+        isLoaded = true;
+        meshDirty = true;
+    }
+}
+
 void Chunk::unload() {
     if (isLoaded) {
         // Clean up voxel data
@@ -31,56 +51,97 @@ void Chunk::unload() {
     }
 }
 
+void Chunk::reset(int x, int y, int z) {
+    unload();
+    posX = x;
+    posY = y;
+    posZ = z;
+    version = nextChunkVersion.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Chunk::copyBorderLayer(int face, uint8_t* out) const {
+    if (voxels.isUniform()) {
+        std::memset(out, voxels.getUniformType(), CHUNK_AREA);
+        return;
+    }
+    
+    const int axis = face / 2;
+    const int slice = (face % 2 == 0) ? 0 : CHUNK_SIZE - 1;
+    for (int b = 0; b < CHUNK_SIZE; ++b) {
+        for (int a = 0; a < CHUNK_SIZE; ++a) {
+            uint8_t type;
+            if (axis == 0) {
+                type = getVoxelType(slice, a, b);
+            } else if (axis == 1) {
+                type = getVoxelType(a, slice, b);
+            } else {
+                type = getVoxelType(a, b, slice);
+            }
+            out[a + b * CHUNK_SIZE] = type;
+        }
+    }
+}
+
+bool ChunkBorders::isSolid() const {
+    const uint8_t* voxel = &layers[0][0];
+    for (int i = 0; i < FACE_COUNT * CHUNK_AREA; ++i) {
+        if (voxel[i] == VoxelType::AIR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Chunk::markMeshDirty() {
+    meshDirty = true;
+    version = nextChunkVersion.fetch_add(1, std::memory_order_relaxed);
+}
+
 void Chunk::update() {
     if (isLoaded) {
         // Update voxel states or perform any necessary calculations
     }
 }
 
-const std::vector<Voxel>& Chunk::getVoxels() const {
-    return voxels;
-}
-
-void Chunk::generateVoxels() {
-    // Create noise generator with a fixed seed for consistent terrain
-    static PerlinNoise noise(TerrainConfig::NOISE_SEED);
+void Chunk::generateVoxels(const ColumnHeights& columns) {
+    // Heights are sampled per column, so the chunk can be classified before
+    // any voxel is written
+    const int* heights = columns.heights;
+    
+    const int chunkBottom = posY * CHUNK_SIZE;
+    
+    // Uniform chunks are stored as a single block ID with no index array
+    const ChunkContent content = HeightmapCache::classify(posY, columns.minHeight, columns.maxHeight);
+    if (content == CHUNK_CONTENT_AIR) {
+        voxels.fill(VoxelType::AIR);
+        return;
+    }
+    if (content == CHUNK_CONTENT_STONE) {
+        voxels.fill(VoxelType::STONE);
+        return;
+    }
     
     for (int x = 0; x < CHUNK_SIZE; ++x) {
         for (int z = 0; z < CHUNK_SIZE; ++z) {
-            // Calculate world coordinates
-            float worldX = posX * CHUNK_SIZE + x;
-            float worldZ = posZ * CHUNK_SIZE + z;
-            
-            // Generate height using octave noise (apply scale during sampling)
-            float noiseValue = noise.octaveNoise(worldX * TerrainConfig::SCALE, 
-                                                  worldZ * TerrainConfig::SCALE,
-                                                  TerrainConfig::OCTAVES, 
-                                                  TerrainConfig::PERSISTENCE);
-            
-            // Convert noise value from [-1, 1] to terrain height
-            int terrainHeight = TerrainConfig::BASE_HEIGHT + 
-                               static_cast<int>(noiseValue * TerrainConfig::HEIGHT_MULTIPLIER);
+            int terrainHeight = heights[x + z * CHUNK_SIZE];
             
             // Fill voxels based on height
             for (int y = 0; y < CHUNK_SIZE; ++y) {
-                int worldY = posY * CHUNK_SIZE + y;
+                int worldY = chunkBottom + y;
                 int index = x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE;
                 
                 // Set voxel type based on height
+                // Storage starts out as air, so only solid voxels are written
                 if (worldY < terrainHeight) {
-                    // Solid terrain
                     if (worldY == terrainHeight - 1) {
-                        voxels[index] = Voxel(x, y, z, 1); // Grass/top layer
-                    } else if (worldY >= terrainHeight - 4) {
-                        voxels[index] = Voxel(x, y, z, 2); // Dirt layer
+                        voxels.set(index, VoxelType::GRASS);
+                    } else if (worldY >= terrainHeight - TerrainConfig::SOIL_DEPTH) {
+                        voxels.set(index, VoxelType::DIRT);
                     } else {
-                        voxels[index] = Voxel(x, y, z, 3); // Stone layer
+                        voxels.set(index, VoxelType::STONE);
                     }
-                } else {
-                    // Air
-                    voxels[index] = Voxel(x, y, z, 0);
                 }
             }
         }
     }
-}
\ No newline at end of file
+}
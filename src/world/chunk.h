@@ -1,38 +1,105 @@
 #ifndef CHUNK_H
 #define CHUNK_H
 
-#include <vector>
+#include <cstdint>
 #include "voxel.h"
+#include "palette_storage.h"
 
 #define CHUNK_SIZE 16
+#define CHUNK_VOLUME (CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE)
+#define CHUNK_AREA (CHUNK_SIZE * CHUNK_SIZE)
+
+// Chunk coordinate containing world voxel coordinate v (floor division, so
+// negative coordinates map to the correct chunk)
+inline int worldToChunk(int v) {
+    return (v >= 0) ? v / CHUNK_SIZE : (v - CHUNK_SIZE + 1) / CHUNK_SIZE;
+}
+
+struct ColumnHeights;
+
+// Chunk face directions
+enum ChunkFace {
+    FACE_NEG_X = 0,
+    FACE_POS_X = 1,
+    FACE_NEG_Y = 2,
+    FACE_POS_Y = 3,
+    FACE_NEG_Z = 4,
+    FACE_POS_Z = 5,
+    FACE_COUNT = 6
+};
+
+// Chunk coordinate offset of the neighbour in each face direction
+constexpr int CHUNK_FACE_OFFSETS[FACE_COUNT][3] = {
+    {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+};
+
+// The voxel layer of each of the six neighbours that touches a chunk.
+// layers[f] holds the layer of the neighbour in direction f, indexed
+// [a + b * CHUNK_SIZE] where (a, b) are the two remaining axes in x, y, z order
+// (X faces: y, z; Y faces: x, z; Z faces: x, y).
+struct ChunkBorders {
+    uint8_t layers[FACE_COUNT][CHUNK_AREA];
+    
+    // True if every border voxel is solid
+    bool isSolid() const;
+};
 
 class Chunk {
 public:
     Chunk(int x, int y, int z);
     ~Chunk();
 
+    // Generate voxels, computing the column's terrain heights or taking
+    // them from a HeightmapCache lookup
     void load();
+    void load(const ColumnHeights& columns);
+    
+    // Load as a single block type without generating (chunks the terrain
+    // bounds prove to be all air or all stone)
+    void loadUniform(uint8_t type);
     void unload();
     void update();
 
+    // Unload and move to another position, keeping the voxel storage's
+    // memory (used by ChunkPool). The chunk gets a fresh version.
+    void reset(int x, int y, int z);
+
     int getPosX() const { return posX; }
     int getPosY() const { return posY; }
     int getPosZ() const { return posZ; }
 
-    const std::vector<Voxel>& getVoxels() const;
+    // Voxel access (local coordinates, 0..CHUNK_SIZE-1, no bounds checks)
+    uint8_t getVoxelType(int x, int y, int z) const {
+        return voxels.get(x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE);
+    }
+    const PaletteStorage& getVoxelStorage() const { return voxels; }
+    
+    // Copy this chunk's outermost voxel layer on the given side (same layout
+    // as ChunkBorders::layers)
+    void copyBorderLayer(int face, uint8_t* out) const;
     
+    // Uniform chunks (all air or all stone) hold a single block ID and no voxel array
+    bool isUniform() const { return voxels.isUniform(); }
+
     // Mesh management
     bool needsMeshRebuild() const { return meshDirty; }
-    void markMeshDirty() { meshDirty = true; }
+    void markMeshDirty();
     void markMeshClean() { meshDirty = false; }
+    
+    // Bumped every time the chunk is marked dirty. Values come from one global
+    // counter, so a chunk reloaded at the same position never reuses the
+    // version of its predecessor. Async mesh results carry the version they
+    // were built from and are discarded if it no longer matches.
+    uint64_t getVersion() const { return version; }
 
 private:
     int posX, posY, posZ;
-    std::vector<Voxel> voxels;
+    PaletteStorage voxels;
     bool isLoaded;
     bool meshDirty;
-    
-    void generateVoxels();
+    uint64_t version;
+
+    void generateVoxels(const ColumnHeights& columns);
 };
 
-#endif // CHUNK_H
\ No newline at end of file
+#endif // CHUNK_H
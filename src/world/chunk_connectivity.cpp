@@ -0,0 +1,71 @@
+#include "chunk_connectivity.h"
+#include "voxel.h"
+
+// Faces of the chunk boundary that voxel (x, y, z) lies on
+static uint32_t getBoundaryFaces(int x, int y, int z) {
+    uint32_t faces = 0;
+    if (x == 0) faces |= 1u << FACE_NEG_X;
+    if (x == CHUNK_SIZE - 1) faces |= 1u << FACE_POS_X;
+    if (y == 0) faces |= 1u << FACE_NEG_Y;
+    if (y == CHUNK_SIZE - 1) faces |= 1u << FACE_POS_Y;
+    if (z == 0) faces |= 1u << FACE_NEG_Z;
+    if (z == CHUNK_SIZE - 1) faces |= 1u << FACE_POS_Z;
+    return faces;
+}
+
+ChunkConnectivityMask ChunkConnectivity::compute(const PaletteStorage& voxels) {
+    if (voxels.isUniform()) {
+        return voxels.getUniformType() == VoxelType::AIR ? ALL : NONE;
+    }
+
+    uint8_t types[CHUNK_VOLUME];
+    voxels.unpack(types);
+
+    // Voxels are marked when pushed, so the stack never holds more than
+    // the chunk's volume
+    bool visited[CHUNK_VOLUME] = {};
+    int stack[CHUNK_VOLUME];
+
+    ChunkConnectivityMask mask = NONE;
+    for (int start = 0; start < CHUNK_VOLUME && mask != ALL; ++start) {
+        if (visited[start] || types[start] != VoxelType::AIR) {
+            continue;
+        }
+
+        // Collect the faces touched by the air region containing `start`
+        uint32_t faces = 0;
+        int stackSize = 0;
+        stack[stackSize++] = start;
+        visited[start] = true;
+        while (stackSize > 0) {
+            const int index = stack[--stackSize];
+            const int x = index % CHUNK_SIZE;
+            const int y = (index / CHUNK_SIZE) % CHUNK_SIZE;
+            const int z = index / CHUNK_AREA;
+            faces |= getBoundaryFaces(x, y, z);
+
+            for (int face = 0; face < FACE_COUNT; ++face) {
+                const int nx = x + CHUNK_FACE_OFFSETS[face][0];
+                const int ny = y + CHUNK_FACE_OFFSETS[face][1];
+                const int nz = z + CHUNK_FACE_OFFSETS[face][2];
+                if (nx < 0 || nx >= CHUNK_SIZE || ny < 0 || ny >= CHUNK_SIZE ||
+                    nz < 0 || nz >= CHUNK_SIZE) {
+                    continue;
+                }
+                const int neighbour = nx + ny * CHUNK_SIZE + nz * CHUNK_AREA;
+                if (!visited[neighbour] && types[neighbour] == VoxelType::AIR) {
+                    visited[neighbour] = true;
+                    stack[stackSize++] = neighbour;
+                }
+            }
+        }
+
+        // Every pair of faces touched by the region can see each other
+        for (int a = 0; a < FACE_COUNT; ++a) {
+            if (faces & (1u << a)) {
+                mask |= static_cast<ChunkConnectivityMask>(faces) << (a * FACE_COUNT);
+            }
+        }
+    }
+    return mask;
+}
@@ -0,0 +1,32 @@
+#ifndef CHUNK_CONNECTIVITY_H
+#define CHUNK_CONNECTIVITY_H
+
+#include <cstdint>
+#include "chunk.h"
+#include "palette_storage.h"
+
+// Which faces of a chunk can see each other through the chunk
+//
+// Bit (a * FACE_COUNT + b) of a mask is set if some connected region of air
+// voxels touches both face a and face b (ChunkFace order). The mask is
+// symmetric, and a face that air touches at all is connected to itself. The
+// renderer walks these masks outward from the camera's chunk to skip chunks
+// that no line of sight can reach (see Renderer::updateOcclusion).
+typedef uint64_t ChunkConnectivityMask;
+
+namespace ChunkConnectivity {
+    // Every face sees every other face (e.g. an all-air chunk)
+    constexpr ChunkConnectivityMask ALL = (uint64_t(1) << (FACE_COUNT * FACE_COUNT)) - 1;
+    // No face sees any other (a chunk without air)
+    constexpr ChunkConnectivityMask NONE = 0;
+
+    inline bool connects(ChunkConnectivityMask mask, int faceA, int faceB) {
+        return ((mask >> (faceA * FACE_COUNT + faceB)) & 1) != 0;
+    }
+
+    // Flood-fill the chunk's air voxels and record which faces each air
+    // region touches. Uniform chunks return ALL or NONE without decoding.
+    ChunkConnectivityMask compute(const PaletteStorage& voxels);
+}
+
+#endif // CHUNK_CONNECTIVITY_H
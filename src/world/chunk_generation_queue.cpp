@@ -0,0 +1,67 @@
+#include "chunk_generation_queue.h"
+#include "heightmap_cache.h"
+#include "utils/thread_pool.h"
+#include <cstdint>
+
+ChunkGenerationQueue::ChunkGenerationQueue() : pool(nullptr), heightmapCache(nullptr) {
+}
+
+ChunkGenerationQueue::~ChunkGenerationQueue() {
+    cleanup();
+}
+
+void ChunkGenerationQueue::init(unsigned int workerCount, HeightmapCache* cache) {
+    heightmapCache = cache;
+    pool = new ThreadPool();
+    pool->init(workerCount);
+}
+
+void ChunkGenerationQueue::cleanup() {
+    // Stop the workers first so no job touches a chunk being deleted
+    if (pool) {
+        pool->cleanup();
+        delete pool;
+        pool = nullptr;
+    }
+
+    inFlightChunks.forEach([](uint64_t, Chunk* chunk) {
+        delete chunk;
+    });
+    inFlightChunks.clear();
+    completedChunks.clear();
+}
+
+void ChunkGenerationQueue::submit(Chunk* chunk) {
+    inFlightChunks[reinterpret_cast<uintptr_t>(chunk)] = chunk;
+
+    HeightmapCache* cache = heightmapCache;
+    pool->submit([this, cache, chunk]() {
+        ColumnHeights columns;
+        cache->getColumn(chunk->getPosX(), chunk->getPosZ(), columns);
+        chunk->load(columns);
+        std::lock_guard<std::mutex> lock(completedMutex);
+        completedChunks.push_back(chunk);
+    });
+}
+
+void ChunkGenerationQueue::collectResults(std::vector<Chunk*>& results) {
+    const size_t first = results.size();
+    {
+        // Swapping keeps both vectors' capacity, so neither reallocates
+        std::lock_guard<std::mutex> lock(completedMutex);
+        if (results.empty()) {
+            results.swap(completedChunks);
+        } else {
+            results.insert(results.end(), completedChunks.begin(), completedChunks.end());
+            completedChunks.clear();
+        }
+    }
+
+    for (size_t i = first; i < results.size(); ++i) {
+        inFlightChunks.erase(reinterpret_cast<uintptr_t>(results[i]));
+    }
+}
+
+unsigned int ChunkGenerationQueue::getWorkerCount() const {
+    return pool ? pool->getWorkerCount() : 0;
+}
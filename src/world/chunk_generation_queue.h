@@ -0,0 +1,48 @@
+#ifndef CHUNK_GENERATION_QUEUE_H
+#define CHUNK_GENERATION_QUEUE_H
+
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include "chunk.h"
+#include "utils/flat_hash_map.h"
+
+class ThreadPool;
+class HeightmapCache;
+
+// Generates chunk terrain on a worker pool
+//
+// A submitted chunk belongs to its job until collectResults() hands it
+// back; nothing else may touch it meanwhile. Finished chunks come back in
+// completion order. Chunks still owned by a job when the queue is cleaned
+// up are deleted.
+class ChunkGenerationQueue {
+public:
+    ChunkGenerationQueue();
+    ~ChunkGenerationQueue();
+
+    // Start the generation workers (0 = hardware concurrency). Jobs read
+    // column heights through `heightmapCache`, which must outlive the queue.
+    void init(unsigned int workerCount, HeightmapCache* heightmapCache);
+    void cleanup();
+
+    // Generate an unloaded chunk whose position is already set
+    void submit(Chunk* chunk);
+
+    // Append all finished chunks to `results` (main thread only)
+    void collectResults(std::vector<Chunk*>& results);
+
+    // Jobs submitted but not yet collected
+    size_t getInFlightCount() const { return inFlightChunks.size(); }
+    unsigned int getWorkerCount() const;
+
+private:
+    ThreadPool* pool;
+    HeightmapCache* heightmapCache;
+    FlatHashMap<Chunk*> inFlightChunks;  // Keyed by address
+
+    std::mutex completedMutex;
+    std::vector<Chunk*> completedChunks;
+};
+
+#endif // CHUNK_GENERATION_QUEUE_H
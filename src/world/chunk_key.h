@@ -0,0 +1,31 @@
+#ifndef CHUNK_KEY_H
+#define CHUNK_KEY_H
+
+#include <cstdint>
+
+// Chunk coordinate packed into 64 bits: 21 bits per axis in two's
+// complement (x in bits 42-62, y in 21-41, z in 0-20), so coordinates in
+// [-1048576, 1048575] round-trip exactly. Bit 63 is always clear, which
+// leaves ~0 free as the empty-slot marker of FlatHashMap.
+typedef uint64_t ChunkKey;
+
+namespace ChunkKeys {
+    constexpr uint64_t AXIS_MASK = (uint64_t(1) << 21) - 1;
+
+    inline ChunkKey pack(int x, int y, int z) {
+        return ((static_cast<uint64_t>(static_cast<uint32_t>(x)) & AXIS_MASK) << 42) |
+               ((static_cast<uint64_t>(static_cast<uint32_t>(y)) & AXIS_MASK) << 21) |
+               (static_cast<uint64_t>(static_cast<uint32_t>(z)) & AXIS_MASK);
+    }
+
+    // Sign-extend a 21-bit field
+    inline int unpackAxis(uint64_t bits) {
+        return static_cast<int32_t>(static_cast<uint32_t>(bits & AXIS_MASK) << 11) >> 11;
+    }
+
+    inline int getX(ChunkKey key) { return unpackAxis(key >> 42); }
+    inline int getY(ChunkKey key) { return unpackAxis(key >> 21); }
+    inline int getZ(ChunkKey key) { return unpackAxis(key); }
+}
+
+#endif // CHUNK_KEY_H
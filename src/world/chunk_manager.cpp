@@ -1,12 +1,8 @@
 #include "chunk_manager.h"
 #include "chunk.h"
-#include "noise.h"
-#include "terrain_config.h"
 #include <vector>
-#include <unordered_map>
-#include <tuple>
-#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 ChunkManager::ChunkManager() {
     // Initialize chunk storage
@@ -16,132 +12,165 @@ ChunkManager::~ChunkManager() {
     cleanup();
 }
 
-void ChunkManager::init() {
-    // Initialize the chunk manager
-    // Could add some initial chunks here if needed
+void ChunkManager::init(unsigned int workerCount) {
+    generationQueue.init(workerCount, &heightmapCache);
 }
 
-void ChunkManager::addChunk(int x, int y, int z) {
-    // Check if chunk already exists
-    if (hasChunk(x, y, z)) {
+void ChunkManager::removeChunk(int x, int y, int z) {
+    const ChunkKey key = ChunkKeys::pack(x, y, z);
+    
+    // Cancel a request that has not been published yet. A queued request is
+    // skipped when popped; a running job still owns its chunk, which is
+    // recycled when the job completes.
+    if (pendingChunks.erase(key)) {
         return;
     }
     
-    Chunk* newChunk = new Chunk(x, y, z);
-    newChunk->load();
-    chunks.push_back(newChunk);
-    chunkMap[std::make_tuple(x, y, z)] = newChunk;
-}
-
-void ChunkManager::removeChunk(int x, int y, int z) {
-    auto key = std::make_tuple(x, y, z);
-    auto mapIt = chunkMap.find(key);
+    ChunkEntry* entry = chunkMap.find(key);
+    if (!entry) {
+        return;
+    }
+    Chunk* chunk = entry->chunk;
+    const uint32_t index = entry->index;
     
-    if (mapIt != chunkMap.end()) {
-        Chunk* chunk = mapIt->second;
-        
-        // Remove from vector
-        auto it = std::remove(chunks.begin(), chunks.end(), chunk);
-        chunks.erase(it, chunks.end());
-        
-        // Remove from map
-        chunkMap.erase(mapIt);
-        
-        // Clean up chunk
-        chunk->unload();
-        delete chunk;
+    // Swap the last chunk into the hole (order of `chunks` is not meaningful)
+    Chunk* last = chunks.back();
+    if (last != chunk) {
+        chunks[index] = last;
+        chunkMap.find(ChunkKeys::pack(last->getPosX(), last->getPosY(), last->getPosZ()))->index = index;
     }
+    chunks.pop_back();
+    
+    chunkMap.erase(key);
+    unloadEvents.push_back(key);
+    
+    chunk->unload();
+    chunkPool.release(chunk);
 }
 
 void ChunkManager::update() {
+    // Safe point in the frame to grow chunkMap
+    publishCompletedChunks();
+    dispatchLoadRequests();
+    
     for (auto& chunk : chunks) {
         chunk->update();
     }
 }
 
+void ChunkManager::publishCompletedChunks() {
+    generationQueue.collectResults(publishingChunks);
+    for (Chunk* chunk : publishingChunks) {
+        const ChunkKey key = ChunkKeys::pack(chunk->getPosX(), chunk->getPosY(), chunk->getPosZ());
+        Chunk** pending = pendingChunks.find(key);
+        if (!pending || *pending != chunk) {
+            // Request was cancelled while the job was running
+            chunkPool.release(chunk);
+            continue;
+        }
+        pendingChunks.erase(key);
+        publishChunk(chunk);
+    }
+    publishingChunks.clear();
+}
+
+void ChunkManager::publishChunk(Chunk* chunk) {
+    const ChunkKey key = ChunkKeys::pack(chunk->getPosX(), chunk->getPosY(), chunk->getPosZ());
+    chunkMap[key] = ChunkEntry{chunk, static_cast<uint32_t>(chunks.size())};
+    chunks.push_back(chunk);
+    remeshEvents.push_back(key);  // Loaded chunks start out dirty
+    
+    // Neighbours may have been waiting for this chunk before meshing
+    // (or were meshed against a previous version of it)
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        Chunk* neighbour = getChunk(chunk->getPosX() + CHUNK_FACE_OFFSETS[face][0],
+                                    chunk->getPosY() + CHUNK_FACE_OFFSETS[face][1],
+                                    chunk->getPosZ() + CHUNK_FACE_OFFSETS[face][2]);
+        if (neighbour) {
+            // A neighbour that is already dirty has an event queued
+            if (!neighbour->needsMeshRebuild()) {
+                remeshEvents.push_back(ChunkKeys::pack(neighbour->getPosX(),
+                                                       neighbour->getPosY(),
+                                                       neighbour->getPosZ()));
+            }
+            neighbour->markMeshDirty();
+        }
+    }
+}
+
 void ChunkManager::cleanup() {
+    // Stops the workers and deletes chunks still owned by jobs
+    generationQueue.cleanup();
+    pendingChunks.clear();
+    publishingChunks.clear();
+    streamer.reset();
+    
     for (auto& chunk : chunks) {
         chunk->unload();
         delete chunk;
     }
     chunks.clear();
     chunkMap.clear();
+    chunkPool.cleanup();
+    heightmapCache.clear();
+    clearChunkEvents();
+}
+
+void ChunkManager::clearChunkEvents() {
+    remeshEvents.clear();
+    unloadEvents.clear();
 }
 
 bool ChunkManager::hasChunk(int x, int y, int z) const {
-    auto key = std::make_tuple(x, y, z);
-    return chunkMap.find(key) != chunkMap.end();
+    return chunkMap.contains(ChunkKeys::pack(x, y, z));
+}
+
+bool ChunkManager::isChunkPending(int x, int y, int z) const {
+    return pendingChunks.contains(ChunkKeys::pack(x, y, z));
 }
 
 Chunk* ChunkManager::getChunk(int x, int y, int z) {
-    auto key = std::make_tuple(x, y, z);
-    auto it = chunkMap.find(key);
-    return (it != chunkMap.end()) ? it->second : nullptr;
+    ChunkEntry* entry = chunkMap.find(ChunkKeys::pack(x, y, z));
+    return entry ? entry->chunk : nullptr;
 }
 
-void ChunkManager::updateChunksAroundCamera(float camX, float camY, float camZ, int renderDistance) {
-    // Convert camera position to chunk coordinates
-    int camChunkX = static_cast<int>(std::floor(camX / CHUNK_SIZE));
-    int camChunkY = static_cast<int>(std::floor(camY / CHUNK_SIZE));
-    int camChunkZ = static_cast<int>(std::floor(camZ / CHUNK_SIZE));
-    
-    // Use squared distance to avoid expensive sqrt calls
-    int renderDistSq = renderDistance * renderDistance;
-    int unloadDistSq = (renderDistance + 1) * (renderDistance + 1);
-    
-    // Load chunks within render distance
-    for (int x = camChunkX - renderDistance; x <= camChunkX + renderDistance; ++x) {
-        for (int y = camChunkY - renderDistance; y <= camChunkY + renderDistance; ++y) {
-            for (int z = camChunkZ - renderDistance; z <= camChunkZ + renderDistance; ++z) {
-                // Calculate squared distance to chunk
-                int dx = x - camChunkX;
-                int dy = y - camChunkY;
-                int dz = z - camChunkZ;
-                int distanceSq = dx*dx + dy*dy + dz*dz;
-                
-                // Only load chunks within the spherical render distance
-                if (distanceSq <= renderDistSq) {
-                    addChunk(x, y, z);
-                }
+bool ChunkManager::getNeighbourBorders(int x, int y, int z, ChunkBorders& borders) const {
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        const int neighbourY = y + CHUNK_FACE_OFFSETS[face][1];
+        const ChunkEntry* neighbour = chunkMap.find(ChunkKeys::pack(x + CHUNK_FACE_OFFSETS[face][0],
+                                                                    neighbourY,
+                                                                    z + CHUNK_FACE_OFFSETS[face][2]));
+        if (!neighbour) {
+            // Unloaded sky and deep stone chunks are virtual neighbours
+            const ChunkContent content = HeightmapCache::classifyLayer(neighbourY);
+            if (content == CHUNK_CONTENT_MIXED) {
+                return false;
             }
+            std::memset(borders.layers[face],
+                        content == CHUNK_CONTENT_AIR ? VoxelType::AIR : VoxelType::STONE, CHUNK_AREA);
+            continue;
         }
+        // The neighbour on our -X side touches us with its +X layer, etc.
+        neighbour->chunk->copyBorderLayer(face ^ 1, borders.layers[face]);
     }
+    return true;
+}
+
+uint8_t ChunkManager::getVoxelType(int worldX, int worldY, int worldZ) const {
+    const int chunkX = worldToChunk(worldX);
+    const int chunkY = worldToChunk(worldY);
+    const int chunkZ = worldToChunk(worldZ);
     
-    // Unload chunks outside render distance
-    std::vector<std::tuple<int, int, int>> chunksToUnload;
-    chunksToUnload.reserve(chunks.size() / 4);  // Reserve space to reduce reallocations
-    
-    for (const auto& chunk : chunks) {
-        int dx = chunk->getPosX() - camChunkX;
-        int dy = chunk->getPosY() - camChunkY;
-        int dz = chunk->getPosZ() - camChunkZ;
-        int distanceSq = dx*dx + dy*dy + dz*dz;
-        
-        // Unload chunks beyond render distance (with small buffer to prevent thrashing)
-        if (distanceSq > unloadDistSq) {
-            chunksToUnload.push_back(std::make_tuple(chunk->getPosX(), chunk->getPosY(), chunk->getPosZ()));
-        }
-    }
-    
-    // Remove chunks that are too far
-    for (const auto& chunkPos : chunksToUnload) {
-        removeChunk(std::get<0>(chunkPos), std::get<1>(chunkPos), std::get<2>(chunkPos));
+    const ChunkEntry* entry = chunkMap.find(ChunkKeys::pack(chunkX, chunkY, chunkZ));
+    if (!entry) {
+        return HeightmapCache::classifyLayer(chunkY) == CHUNK_CONTENT_STONE ? VoxelType::STONE : VoxelType::AIR;
     }
+    return entry->chunk->getVoxelType(worldX - chunkX * CHUNK_SIZE,
+                                      worldY - chunkY * CHUNK_SIZE,
+                                      worldZ - chunkZ * CHUNK_SIZE);
 }
 
 float ChunkManager::getTerrainHeightAt(float worldX, float worldZ) const {
-    // Use the same noise generator and parameters as chunk generation
-    static PerlinNoise noise(TerrainConfig::NOISE_SEED);
-    
-    // Generate height using octave noise
-    float noiseValue = noise.octaveNoise(worldX * TerrainConfig::SCALE, 
-                                         worldZ * TerrainConfig::SCALE, 
-                                         TerrainConfig::OCTAVES, 
-                                         TerrainConfig::PERSISTENCE);
-    
-    // Convert noise value to terrain height
-    float terrainHeight = TerrainConfig::BASE_HEIGHT + 
-                         noiseValue * TerrainConfig::HEIGHT_MULTIPLIER;
-    
-    return terrainHeight;
-}
\ No newline at end of file
+    return static_cast<float>(heightmapCache.getHeightAt(static_cast<int>(std::floor(worldX)),
+                                                         static_cast<int>(std::floor(worldZ))));
+}
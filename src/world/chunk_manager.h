@@ -2,24 +2,57 @@
 #define CHUNK_MANAGER_H
 
 #include <vector>
-#include <unordered_map>
-#include <tuple>
 #include "chunk.h"
-#include "utils/tuple_hash.h"
+#include "chunk_generation_queue.h"
+#include "chunk_key.h"
+#include "chunk_pool.h"
+#include "chunk_streamer.h"
+#include "heightmap_cache.h"
+#include "streaming_config.h"
+#include "utils/flat_hash_map.h"
 
 class ChunkManager {
 public:
     ChunkManager();
     ~ChunkManager();
 
-    void init();
+    // Start the chunk generation workers (0 = hardware concurrency)
+    void init(unsigned int workerCount = 0);
+    
+    void setStreamingConfig(const StreamingConfig& config) { streamingConfig = config; }
+    
+    // Request a chunk. Requests wait in a priority queue (see
+    // getStreamingPriority()) and are handed to the generation workers by
+    // update() within the per-frame budget. The chunk becomes visible
+    // through getChunks()/getChunk() once a later update() publishes it.
+    // Chunks known to be all air or all stone skip the workers, and with
+    // StreamingConfig::skipUniformLayers entire such layers are not loaded.
     void addChunk(int x, int y, int z);
     void removeChunk(int x, int y, int z);
+    
+    // Per-frame tick: publishes chunks finished by the workers and
+    // dispatches the most urgent load requests
     void update();
     void cleanup();
     
-    // Dynamic chunk loading around camera
-    void updateChunksAroundCamera(float camX, float camY, float camZ, int renderDistance);
+    // Camera view direction (need not be normalised), used to load chunks
+    // in front of the camera before those behind it
+    void setViewDirection(float dirX, float dirY, float dirZ);
+    
+    // Urgency of chunk (x, y, z) for loading and meshing; lower is sooner.
+    // Squared distance from the camera chunk, scaled from 1x for chunks
+    // straight ahead to 3x for chunks straight behind.
+    float getStreamingPriority(int x, int y, int z) const { return streamer.getStreamingPriority(x, y, z); }
+    
+    // Dynamic chunk loading around camera. The streaming window is a
+    // cylinder (in chunks): chunks within horizontalDistance horizontally
+    // and verticalDistance vertically are requested, chunks beyond either
+    // radius + 1 are unloaded. With StreamingConfig::skipUniformLayers the
+    // window is further clipped to the terrain band. Only does work when the
+    // camera enters a new chunk: a step to a neighbouring chunk touches just
+    // the shells of cells entering and leaving the window.
+    void updateChunksAroundCamera(float camX, float camY, float camZ,
+                                  int horizontalDistance, int verticalDistance);
     
     // Get all active chunks
     const std::vector<Chunk*>& getChunks() const { return chunks; }
@@ -27,15 +60,76 @@ public:
     // Check if a chunk exists at given position
     bool hasChunk(int x, int y, int z) const;
     
+    // Check if a chunk is queued or being generated at given position
+    bool isChunkPending(int x, int y, int z) const;
+    size_t getPendingChunkCount() const { return pendingChunks.size(); }
+    
     // Get chunk at position (returns nullptr if not found)
     Chunk* getChunk(int x, int y, int z);
     
-    // Get terrain height at world position (for camera spawning)
+    // Chunk events since the last clearChunkEvents(), for consumers that
+    // mirror chunk state (the renderer's draw list). Remesh events name
+    // chunks whose mesh became dirty (newly loaded, or a neighbour arrived);
+    // a chunk may have been unloaded again by the time it is read.
+    const std::vector<ChunkKey>& getRemeshEvents() const { return remeshEvents; }
+    const std::vector<ChunkKey>& getUnloadEvents() const { return unloadEvents; }
+    void clearChunkEvents();
+    
+    // Gather the border layers of the six neighbours of chunk (x, y, z).
+    // Neighbours in all-air or all-stone layers need not be loaded (their
+    // layers are filled analytically). Returns false if any other neighbour
+    // is not loaded yet.
+    bool getNeighbourBorders(int x, int y, int z, ChunkBorders& borders) const;
+    
+    // Get block type at a world voxel position (air if the chunk is not
+    // loaded, unless its layer is known to be solid stone)
+    uint8_t getVoxelType(int worldX, int worldY, int worldZ) const;
+    
+    // Get terrain height at world position (for camera spawning): the top
+    // of the voxel column containing it, from the shared heightmap cache
     float getTerrainHeightAt(float worldX, float worldZ) const;
 
 private:
+    // A published chunk and its position in `chunks`, so removal can swap
+    // the last chunk into its place instead of searching the vector
+    struct ChunkEntry {
+        Chunk* chunk;
+        uint32_t index;
+    };
+    
     std::vector<Chunk*> chunks;
-    std::unordered_map<std::tuple<int, int, int>, Chunk*, TupleHash> chunkMap;  // For O(1) lookup
+    FlatHashMap<ChunkEntry> chunkMap;  // For O(1) lookup
+    ChunkPool chunkPool;               // Recycles unloaded chunks
+    mutable HeightmapCache heightmapCache;  // Column heights shared by stacked chunks
+    
+    // Background generation. A pending chunk maps to nullptr while its
+    // request is still in the load queue. Jobs of cancelled requests still
+    // own their chunk until it is collected.
+    ChunkGenerationQueue generationQueue;
+    StreamingConfig streamingConfig;
+    FlatHashMap<Chunk*> pendingChunks;    // Requested, not yet published
+    std::vector<Chunk*> publishingChunks;  // Finished jobs collected this frame
+    
+    // Pending events; cleared by the consumer, so capacity is reused
+    std::vector<ChunkKey> remeshEvents;
+    std::vector<ChunkKey> unloadEvents;
+    
+    // Streaming window and load queue; scratch lists of the chunks that
+    // enter and leave the window on a move
+    ChunkStreamer streamer;
+    std::vector<ChunkKey> windowEnter;
+    std::vector<ChunkKey> windowLeave;
+    
+    void publishCompletedChunks();
+    void publishChunk(Chunk* chunk);
+    void dispatchLoadRequests();
+    
+    // Load a requested chunk: uniform chunks are published at once, others
+    // get a generation job. Returns true if a job was started.
+    bool startChunkLoad(int x, int y, int z);
+    
+    // Remove loaded and pending chunks outside the unload window
+    void unloadOutsideWindow();
 };
 
 #endif // CHUNK_MANAGER_H
\ No newline at end of file
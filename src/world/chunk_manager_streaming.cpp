@@ -0,0 +1,117 @@
+#include "chunk_manager.h"
+#include <vector>
+#include <cmath>
+
+// Streaming half of ChunkManager: moving the window with the camera and
+// turning load requests into generation jobs. Ownership, publishing and
+// voxel queries live in chunk_manager.cpp.
+
+void ChunkManager::addChunk(int x, int y, int z) {
+    // Check if chunk already exists or is already requested
+    // Sky and deep stone layers are answered analytically. Checked first:
+    // this clamps the streaming window to the terrain band.
+    if (streamingConfig.skipUniformLayers &&
+        HeightmapCache::classifyLayer(y) != CHUNK_CONTENT_MIXED) {
+        return;
+    }
+    
+    if (hasChunk(x, y, z) || isChunkPending(x, y, z)) {
+        return;
+    }
+    
+    pendingChunks[ChunkKeys::pack(x, y, z)] = nullptr;
+    streamer.queueLoad(x, y, z);
+}
+
+void ChunkManager::dispatchLoadRequests() {
+    const size_t maxInFlight = streamingConfig.maxGenerationJobsInFlight > 0
+        ? streamingConfig.maxGenerationJobsInFlight
+        : generationQueue.getWorkerCount() * 2;
+    const size_t inFlight = generationQueue.getInFlightCount();
+    const size_t jobSlots = maxInFlight > inFlight ? maxInFlight - inFlight : 0;
+    streamer.dispatchLoadRequests(pendingChunks, streamingConfig.generationJobsPerFrame, jobSlots,
+                                  [this](int x, int y, int z) { return startChunkLoad(x, y, z); });
+}
+
+bool ChunkManager::startChunkLoad(int x, int y, int z) {
+    const ChunkKey key = ChunkKeys::pack(x, y, z);
+    
+    // Chunks entirely above or below the surface of their column need
+    // no generation job
+    const ChunkContent content = heightmapCache.classifyChunk(x, y, z);
+    if (content != CHUNK_CONTENT_MIXED) {
+        Chunk* uniformChunk = chunkPool.acquire(x, y, z);
+        uniformChunk->loadUniform(content == CHUNK_CONTENT_AIR ? VoxelType::AIR : VoxelType::STONE);
+        pendingChunks.erase(key);
+        publishChunk(uniformChunk);
+        return false;
+    }
+    
+    // Generate off the main thread; the chunk is not reachable from
+    // chunkMap until publishCompletedChunks() picks it up
+    Chunk* newChunk = chunkPool.acquire(x, y, z);
+    pendingChunks[key] = newChunk;
+    generationQueue.submit(newChunk);
+    return true;
+}
+
+void ChunkManager::setViewDirection(float dirX, float dirY, float dirZ) {
+    if (streamer.setViewDirection(dirX, dirY, dirZ)) {
+        streamer.reprioritiseLoadQueue(pendingChunks);
+    }
+}
+
+void ChunkManager::updateChunksAroundCamera(float camX, float camY, float camZ,
+                                            int horizontalDistance, int verticalDistance) {
+    if (horizontalDistance != streamer.getHorizontalRadius()) {
+        // Keep the columns of the unload window plus a ring of slack, so a
+        // column is only evicted once the camera has moved away from it
+        const size_t columnSpan = 2 * static_cast<size_t>(horizontalDistance + 2) + 1;
+        heightmapCache.setCapacity(columnSpan * columnSpan);
+    }
+    
+    // Convert camera position to chunk coordinates
+    windowEnter.clear();
+    windowLeave.clear();
+    const WindowMove move = streamer.moveWindow(static_cast<int>(std::floor(camX / CHUNK_SIZE)),
+                                                static_cast<int>(std::floor(camY / CHUNK_SIZE)),
+                                                static_cast<int>(std::floor(camZ / CHUNK_SIZE)),
+                                                horizontalDistance, verticalDistance,
+                                                windowEnter, windowLeave);
+    if (move == WINDOW_UNCHANGED) {
+        return;
+    }
+    
+    for (ChunkKey key : windowLeave) {
+        removeChunk(ChunkKeys::getX(key), ChunkKeys::getY(key), ChunkKeys::getZ(key));
+    }
+    for (ChunkKey key : windowEnter) {
+        addChunk(ChunkKeys::getX(key), ChunkKeys::getY(key), ChunkKeys::getZ(key));
+    }
+    if (move == WINDOW_RESET) {
+        // First update, radius change or teleport
+        unloadOutsideWindow();
+    }
+    
+    streamer.reprioritiseLoadQueue(pendingChunks);
+}
+
+void ChunkManager::unloadOutsideWindow() {
+    std::vector<ChunkKey> chunksToUnload;
+    for (const auto& chunk : chunks) {
+        if (streamer.isOutsideUnloadWindow(chunk->getPosX(), chunk->getPosY(), chunk->getPosZ())) {
+            chunksToUnload.push_back(ChunkKeys::pack(chunk->getPosX(), chunk->getPosY(), chunk->getPosZ()));
+        }
+    }
+    
+    // Cancel generation requests the camera has moved away from
+    pendingChunks.forEach([&](ChunkKey key, Chunk*) {
+        if (streamer.isOutsideUnloadWindow(ChunkKeys::getX(key), ChunkKeys::getY(key), ChunkKeys::getZ(key))) {
+            chunksToUnload.push_back(key);
+        }
+    });
+    
+    for (ChunkKey key : chunksToUnload) {
+        removeChunk(ChunkKeys::getX(key), ChunkKeys::getY(key), ChunkKeys::getZ(key));
+    }
+}
@@ -0,0 +1,139 @@
+#include "chunk_occlusion.h"
+#include "heightmap_cache.h"
+
+ChunkOcclusion::ChunkOcclusion() : radius(0), halfHeight(0), dirty(true) {
+    origin[0] = origin[1] = origin[2] = 0;
+}
+
+void ChunkOcclusion::setConnectivity(ChunkKey key, const ChunkConnectivityMask* mask) {
+    bool changed;
+    if (!mask) {
+        changed = connectivity.erase(key);
+    } else {
+        ChunkConnectivityMask* existing = connectivity.find(key);
+        changed = !existing || *existing != *mask;
+        if (existing) {
+            *existing = *mask;
+        } else {
+            connectivity[key] = *mask;
+        }
+    }
+
+    // Chunks outside the grid cannot change the current search; they are
+    // picked up when the grid moves over them
+    if (changed && getCell(key) >= 0) {
+        dirty = true;
+    }
+}
+
+ChunkConnectivityMask ChunkOcclusion::getConnectivity(int chunkX, int chunkY, int chunkZ) const {
+    const ChunkConnectivityMask* mask = connectivity.find(ChunkKeys::pack(chunkX, chunkY, chunkZ));
+    if (mask) {
+        return *mask;
+    }
+    // Not meshed yet (or not loaded): assume it is open so nothing behind it
+    // disappears, except for layers that are solid stone everywhere
+    return HeightmapCache::classifyLayer(chunkY) == CHUNK_CONTENT_STONE ?
+        ChunkConnectivity::NONE : ChunkConnectivity::ALL;
+}
+
+void ChunkOcclusion::update(int cameraX, int cameraY, int cameraZ, int newRadius, int newHalfHeight) {
+    if (!dirty && !grid.empty() && newRadius == radius && newHalfHeight == halfHeight &&
+        cameraX == origin[0] && cameraY == origin[1] && cameraZ == origin[2]) {
+        return;
+    }
+
+    dirty = false;
+    radius = newRadius;
+    halfHeight = newHalfHeight;
+    origin[0] = cameraX;
+    origin[1] = cameraY;
+    origin[2] = cameraZ;
+
+    // Cells are ordered x, then z, then y
+    const int width = 2 * radius + 1;
+    const int height = 2 * halfHeight + 1;
+    const size_t cellCount = static_cast<size_t>(width) * width * height;
+    grid.assign(cellCount, 0);
+    cellConnectivity.resize(cellCount);
+    const int cellStep[3] = {1, width * width, width};
+    const int half[3] = {radius, halfHeight, radius};
+
+    // Breadth-first walk over chunk faces. A chunk entered through face e
+    // is left through face f only if its air connects e to f, and a path
+    // never turns back along an axis it has already stepped along the other
+    // way, which keeps the walk from wrapping around solid terrain. A chunk
+    // is revisited if it is entered through a new face.
+    queue.clear();
+    const uint32_t originCell = static_cast<uint32_t>(radius + radius * width + halfHeight * width * width);
+    grid[originCell] = CELL_REACHED;
+    queue.push_back({originCell, static_cast<uint8_t>(FACE_COUNT), 0});
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const Step step = queue[head];
+        const int local[3] = {
+            static_cast<int>(step.cell % width),
+            static_cast<int>(step.cell / (width * width)),
+            static_cast<int>((step.cell / width) % width)
+        };
+
+        // Look each chunk's connectivity up once, however many faces it
+        // is entered through
+        ChunkConnectivityMask mask = ChunkConnectivity::ALL;
+        if (step.entryFace != FACE_COUNT) {
+            if (!(grid[step.cell] & CELL_RESOLVED)) {
+                cellConnectivity[step.cell] = getConnectivity(origin[0] + local[0] - half[0],
+                                                              origin[1] + local[1] - half[1],
+                                                              origin[2] + local[2] - half[2]);
+                grid[step.cell] |= CELL_RESOLVED;
+            }
+            mask = cellConnectivity[step.cell];
+        }
+
+        for (int face = 0; face < FACE_COUNT; ++face) {
+            const int opposite = face ^ 1;
+            if ((step.directions & (1u << opposite)) ||
+                (step.entryFace != FACE_COUNT && !ChunkConnectivity::connects(mask, step.entryFace, face))) {
+                continue;
+            }
+
+            const int axis = face / 2;
+            const int next = local[axis] + CHUNK_FACE_OFFSETS[face][axis];
+            if (next < 0 || next > 2 * half[axis]) {
+                continue;
+            }
+
+            const uint32_t cell = static_cast<uint32_t>(step.cell + CHUNK_FACE_OFFSETS[face][axis] * cellStep[axis]);
+            const uint8_t entryBit = static_cast<uint8_t>(1u << opposite);
+            if (grid[cell] & entryBit) {
+                continue;
+            }
+            grid[cell] |= CELL_REACHED | entryBit;
+            queue.push_back({cell, static_cast<uint8_t>(opposite),
+                             static_cast<uint8_t>(step.directions | (1u << face))});
+        }
+    }
+}
+
+int64_t ChunkOcclusion::getCell(ChunkKey key) const {
+    const int x = ChunkKeys::getX(key) - origin[0] + radius;
+    const int y = ChunkKeys::getY(key) - origin[1] + halfHeight;
+    const int z = ChunkKeys::getZ(key) - origin[2] + radius;
+    const int width = 2 * radius + 1;
+    if (grid.empty() || x < 0 || x >= width || z < 0 || z >= width || y < 0 || y > 2 * halfHeight) {
+        return -1;
+    }
+    return x + static_cast<int64_t>(z) * width + static_cast<int64_t>(y) * width * width;
+}
+
+bool ChunkOcclusion::isVisible(ChunkKey key) const {
+    const int64_t cell = getCell(key);
+    return cell < 0 || (grid[static_cast<size_t>(cell)] & CELL_REACHED) != 0;
+}
+
+void ChunkOcclusion::clear() {
+    connectivity.clear();
+    grid.clear();
+    queue.clear();
+    dirty = true;
+}
@@ -0,0 +1,62 @@
+#ifndef CHUNK_OCCLUSION_H
+#define CHUNK_OCCLUSION_H
+
+#include <cstdint>
+#include <vector>
+#include "chunk_connectivity.h"
+#include "chunk_key.h"
+#include "utils/flat_hash_map.h"
+
+// Cave occlusion: which chunks the camera's chunk can see through the
+// face-to-face connectivity of the chunks in between
+//
+// The search covers a grid of chunks around the camera chunk; each cell
+// records whether its chunk was reached (bit 7), whether its connectivity
+// has been looked up for this search (bit 6) and which entry faces it has
+// been expanded from (bits 0-5). It is only redone when the camera changes
+// chunk, the grid size changes or a connectivity inside the grid changes.
+class ChunkOcclusion {
+public:
+    ChunkOcclusion();
+
+    // Record (or with nullptr, forget) the connectivity of a chunk
+    void setConnectivity(ChunkKey key, const ChunkConnectivityMask* connectivity);
+
+    // Redo the search from chunk (cameraX, cameraY, cameraZ) over a grid
+    // reaching `radius` chunks horizontally and `halfHeight` vertically,
+    // unless nothing has changed since the last one
+    void update(int cameraX, int cameraY, int cameraZ, int radius, int halfHeight);
+
+    // True if the last search reached the chunk (chunks outside the grid pass)
+    bool isVisible(ChunkKey key) const;
+
+    // Forget every connectivity and the last search
+    void clear();
+
+private:
+    struct Step {
+        uint32_t cell;
+        uint8_t entryFace;   // FACE_COUNT for the camera's chunk
+        uint8_t directions;  // Bit f set if the path has stepped in direction f
+    };
+    static const uint8_t CELL_REACHED = 0x80;
+    static const uint8_t CELL_RESOLVED = 0x40;  // cellConnectivity is valid
+
+    FlatHashMap<ChunkConnectivityMask> connectivity;
+    std::vector<uint8_t> grid;
+    std::vector<ChunkConnectivityMask> cellConnectivity;  // Per cell, filled on first visit
+    std::vector<Step> queue;
+    int origin[3];
+    int radius;      // Horizontal half-size of the grid in chunks
+    int halfHeight;  // Vertical half-size of the grid in chunks
+    bool dirty;
+
+    // Connectivity of a chunk; chunks without a mesh yet count as open unless
+    // their whole layer lies below the terrain
+    ChunkConnectivityMask getConnectivity(int chunkX, int chunkY, int chunkZ) const;
+
+    // Grid cell of a chunk, or -1 if it lies outside the grid
+    int64_t getCell(ChunkKey key) const;
+};
+
+#endif // CHUNK_OCCLUSION_H
@@ -0,0 +1,37 @@
+#include "chunk_pool.h"
+
+ChunkPool::ChunkPool(size_t maxFreeChunks)
+    : maxFreeChunks(maxFreeChunks) {
+}
+
+ChunkPool::~ChunkPool() {
+    cleanup();
+}
+
+Chunk* ChunkPool::acquire(int x, int y, int z) {
+    if (freeChunks.empty()) {
+        return new Chunk(x, y, z);
+    }
+
+    Chunk* chunk = freeChunks.back();
+    freeChunks.pop_back();
+    chunk->reset(x, y, z);
+    return chunk;
+}
+
+void ChunkPool::release(Chunk* chunk) {
+    if (freeChunks.size() >= maxFreeChunks) {
+        delete chunk;
+        return;
+    }
+
+    // Voxel memory is kept until the chunk is reset for its next position
+    freeChunks.push_back(chunk);
+}
+
+void ChunkPool::cleanup() {
+    for (Chunk* chunk : freeChunks) {
+        delete chunk;
+    }
+    freeChunks.clear();
+}
@@ -0,0 +1,38 @@
+#ifndef CHUNK_POOL_H
+#define CHUNK_POOL_H
+
+#include <cstddef>
+#include <vector>
+#include "chunk.h"
+
+// Free list of unloaded Chunk objects
+//
+// Streaming unloads and loads chunks continuously while the camera moves.
+// Recycling them avoids a new/delete per chunk, and a recycled chunk keeps
+// its palette and index array capacity, so regenerating it usually does not
+// allocate at all. Main thread only.
+class ChunkPool {
+public:
+    static const size_t DEFAULT_MAX_FREE_CHUNKS = 4096;
+
+    explicit ChunkPool(size_t maxFreeChunks = DEFAULT_MAX_FREE_CHUNKS);
+    ~ChunkPool();
+
+    // An unloaded chunk at (x, y, z), recycled if one is available
+    Chunk* acquire(int x, int y, int z);
+
+    // Return a chunk that is no longer referenced anywhere. Chunks beyond
+    // the free list limit are deleted.
+    void release(Chunk* chunk);
+
+    // Delete all free chunks
+    void cleanup();
+
+    size_t getFreeCount() const { return freeChunks.size(); }
+
+private:
+    std::vector<Chunk*> freeChunks;
+    size_t maxFreeChunks;
+};
+
+#endif // CHUNK_POOL_H
@@ -0,0 +1,207 @@
+#include "chunk_streamer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+ChunkStreamer::ChunkStreamer()
+    : active(false), centerX(0), centerY(0), centerZ(0),
+      horizontalRadius(-1), verticalRadius(-1),
+      viewDirX(0.0f), viewDirY(0.0f), viewDirZ(-1.0f),
+      queueViewX(0.0f), queueViewY(0.0f), queueViewZ(-1.0f) {
+}
+
+void ChunkStreamer::reset() {
+    active = false;
+    loadQueue.clear();
+}
+
+WindowMove ChunkStreamer::moveWindow(int newCenterX, int newCenterY, int newCenterZ,
+                                     int horizontalDistance, int verticalDistance,
+                                     std::vector<ChunkKey>& enter, std::vector<ChunkKey>& leave) {
+    if (horizontalDistance != horizontalRadius || verticalDistance != verticalRadius) {
+        buildStreamingTables(horizontalDistance, verticalDistance);
+        active = false;
+    }
+
+    const int dx = newCenterX - centerX;
+    const int dy = newCenterY - centerY;
+    const int dz = newCenterZ - centerZ;
+    if (active && dx == 0 && dy == 0 && dz == 0) {
+        return WINDOW_UNCHANGED;  // Still inside the same chunk: nothing can have changed
+    }
+
+    // Move the centre first so new and queued requests are scored from it
+    const bool stepped = active && std::abs(dx) <= 1 && std::abs(dy) <= 1 && std::abs(dz) <= 1;
+    const int oldCenterX = centerX;
+    const int oldCenterY = centerY;
+    const int oldCenterZ = centerZ;
+    active = true;
+    centerX = newCenterX;
+    centerY = newCenterY;
+    centerZ = newCenterZ;
+
+    if (!stepped) {
+        for (const ChunkOffset& offset : loadOffsets) {
+            enter.push_back(ChunkKeys::pack(centerX + offset.x, centerY + offset.y, centerZ + offset.z));
+        }
+        return WINDOW_RESET;
+    }
+
+    // Every resident or pending chunk lies within the unload radius of the
+    // old centre, so the leave shell covers everything to unload and the
+    // enter shell everything that was not already requested
+    const int step = stepIndex(dx, dy, dz);
+    for (const ChunkOffset& offset : leaveShells[step]) {
+        leave.push_back(ChunkKeys::pack(oldCenterX + offset.x, oldCenterY + offset.y, oldCenterZ + offset.z));
+    }
+    for (const ChunkOffset& offset : enterShells[step]) {
+        enter.push_back(ChunkKeys::pack(centerX + offset.x, centerY + offset.y, centerZ + offset.z));
+    }
+    return WINDOW_STEPPED;
+}
+
+bool ChunkStreamer::isOutsideUnloadWindow(int x, int y, int z) const {
+    // Small buffer beyond the load radius to prevent thrashing
+    const int unloadHorizontal = horizontalRadius + 1;
+    const int dx = x - centerX;
+    const int dz = z - centerZ;
+    return dx*dx + dz*dz > unloadHorizontal * unloadHorizontal ||
+           std::abs(y - centerY) > verticalRadius + 1;
+}
+
+bool ChunkStreamer::setViewDirection(float dirX, float dirY, float dirZ) {
+    const float length = std::sqrt(dirX * dirX + dirY * dirY + dirZ * dirZ);
+    if (length <= 0.0f) {
+        return false;
+    }
+    viewDirX = dirX / length;
+    viewDirY = dirY / length;
+    viewDirZ = dirZ / length;
+
+    // Turning changes priorities slowly; only resort after about 25 degrees
+    return viewDirX * queueViewX + viewDirY * queueViewY + viewDirZ * queueViewZ < 0.9f;
+}
+
+float ChunkStreamer::getStreamingPriority(int x, int y, int z) const {
+    const float dx = static_cast<float>(x - centerX);
+    const float dy = static_cast<float>(y - centerY);
+    const float dz = static_cast<float>(z - centerZ);
+    const float distanceSq = dx * dx + dy * dy + dz * dz;
+    if (distanceSq == 0.0f) {
+        return 0.0f;
+    }
+
+    const float cosAngle = (dx * viewDirX + dy * viewDirY + dz * viewDirZ) / std::sqrt(distanceSq);
+    return distanceSq * (2.0f - cosAngle);
+}
+
+void ChunkStreamer::queueLoad(int x, int y, int z) {
+    loadQueue.push_back({getStreamingPriority(x, y, z), x, y, z});
+    std::push_heap(loadQueue.begin(), loadQueue.end(), isLater);
+}
+
+bool ChunkStreamer::isWaiting(const FlatHashMap<Chunk*>& pendingChunks, int x, int y, int z) {
+    // Cancelled requests are gone from the map; dispatched ones have a chunk
+    Chunk* const* pending = pendingChunks.find(ChunkKeys::pack(x, y, z));
+    return pending && !*pending;
+}
+
+void ChunkStreamer::reprioritiseLoadQueue(const FlatHashMap<Chunk*>& pendingChunks) {
+    // Drop stale entries while rescoring, then restore the heap
+    size_t kept = 0;
+    for (const LoadRequest& request : loadQueue) {
+        if (!isWaiting(pendingChunks, request.x, request.y, request.z)) {
+            continue;
+        }
+        LoadRequest& slot = loadQueue[kept++];
+        slot = request;
+        slot.priority = getStreamingPriority(request.x, request.y, request.z);
+    }
+    loadQueue.resize(kept);
+    std::make_heap(loadQueue.begin(), loadQueue.end(), isLater);
+
+    queueViewX = viewDirX;
+    queueViewY = viewDirY;
+    queueViewZ = viewDirZ;
+}
+
+void ChunkStreamer::dispatchLoadRequests(const FlatHashMap<Chunk*>& pendingChunks,
+                                         unsigned int jobBudget, size_t jobSlots,
+                                         const std::function<bool(int, int, int)>& startLoad) {
+    unsigned int started = 0;
+    while (!loadQueue.empty() && started < jobSlots && (jobBudget == 0 || started < jobBudget)) {
+        std::pop_heap(loadQueue.begin(), loadQueue.end(), isLater);
+        const LoadRequest request = loadQueue.back();
+        loadQueue.pop_back();
+
+        // Skip cancelled requests, and duplicates of a request that was
+        // cancelled and made again
+        if (!isWaiting(pendingChunks, request.x, request.y, request.z)) {
+            continue;
+        }
+        if (startLoad(request.x, request.y, request.z)) {
+            ++started;
+        }
+    }
+}
+
+void ChunkStreamer::buildStreamingTables(int horizontalDistance, int verticalDistance) {
+    horizontalRadius = horizontalDistance;
+    verticalRadius = verticalDistance;
+
+    // Small buffer to prevent thrashing
+    const int unloadHorizontal = horizontalDistance + 1;
+    const int unloadVertical = verticalDistance + 1;
+    auto lengthSq = [](int x, int y, int z) { return x*x + y*y + z*z; };
+    auto inLoadWindow = [&](int x, int y, int z) {
+        return x*x + z*z <= horizontalDistance * horizontalDistance && std::abs(y) <= verticalDistance;
+    };
+    auto inUnloadWindow = [&](int x, int y, int z) {
+        return x*x + z*z <= unloadHorizontal * unloadHorizontal && std::abs(y) <= unloadVertical;
+    };
+
+    loadOffsets.clear();
+    for (int x = -horizontalDistance; x <= horizontalDistance; ++x) {
+        for (int y = -verticalDistance; y <= verticalDistance; ++y) {
+            for (int z = -horizontalDistance; z <= horizontalDistance; ++z) {
+                if (inLoadWindow(x, y, z)) {
+                    loadOffsets.push_back({x, y, z});
+                }
+            }
+        }
+    }
+    std::stable_sort(loadOffsets.begin(), loadOffsets.end(),
+        [&lengthSq](const ChunkOffset& a, const ChunkOffset& b) {
+            return lengthSq(a.x, a.y, a.z) < lengthSq(b.x, b.y, b.z);
+        });
+
+    for (int sx = -1; sx <= 1; ++sx) {
+        for (int sy = -1; sy <= 1; ++sy) {
+            for (int sz = -1; sz <= 1; ++sz) {
+                const int step = stepIndex(sx, sy, sz);
+                enterShells[step].clear();
+                leaveShells[step].clear();
+
+                // Entering: inside the load window around the new centre but
+                // outside it around the old one (offset + step from there)
+                for (const ChunkOffset& o : loadOffsets) {
+                    if (!inLoadWindow(o.x + sx, o.y + sy, o.z + sz)) {
+                        enterShells[step].push_back(o);
+                    }
+                }
+
+                // Leaving: inside the unload window around the old centre but
+                // outside it around the new one (offset - step from there)
+                for (int x = -unloadHorizontal; x <= unloadHorizontal; ++x) {
+                    for (int y = -unloadVertical; y <= unloadVertical; ++y) {
+                        for (int z = -unloadHorizontal; z <= unloadHorizontal; ++z) {
+                            if (inUnloadWindow(x, y, z) && !inUnloadWindow(x - sx, y - sy, z - sz)) {
+                                leaveShells[step].push_back({x, y, z});
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef CHUNK_STREAMER_H
+#define CHUNK_STREAMER_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "chunk.h"
+#include "chunk_key.h"
+#include "utils/flat_hash_map.h"
+
+// Chunk coordinate offset relative to the streaming centre
+struct ChunkOffset {
+    int x, y, z;
+};
+
+// How ChunkStreamer::moveWindow() moved the streaming window
+enum WindowMove {
+    WINDOW_UNCHANGED = 0,  // Still centred on the same chunk
+    WINDOW_STEPPED = 1,    // Stepped to a neighbouring chunk: only the shells changed
+    WINDOW_RESET = 2       // First update, radius change or teleport
+};
+
+// Streaming window and load queue of the ChunkManager
+//
+// The window is a cylinder of chunks around the camera's chunk. Offset
+// tables for the whole window and for the shells entering and leaving it
+// on a step to any neighbouring chunk are built once per radius, so a step
+// only touches those shells. Load requests wait in a binary heap ordered by
+// getStreamingPriority(); cancelled requests stay in the heap until popped
+// or reprioritised. The streamer only decides what to load and when: the
+// ChunkManager owns the chunks and the generation jobs.
+class ChunkStreamer {
+public:
+    ChunkStreamer();
+
+    // Forget the window and every queued request
+    void reset();
+
+    // Centre the window on chunk (centerX, centerY, centerZ). Chunks that
+    // enter the load window are appended to `enter` (nearest first on a
+    // reset) and chunks that leave the unload window to `leave`. After a
+    // reset `leave` stays empty: everything loaded outside the unload window
+    // has to go (see isOutsideUnloadWindow()).
+    WindowMove moveWindow(int centerX, int centerY, int centerZ,
+                          int horizontalDistance, int verticalDistance,
+                          std::vector<ChunkKey>& enter, std::vector<ChunkKey>& leave);
+
+    // Chunks beyond either radius + 1 of the current centre are unloaded
+    bool isOutsideUnloadWindow(int x, int y, int z) const;
+    int getHorizontalRadius() const { return horizontalRadius; }
+
+    // Camera view direction (need not be normalised). Returns true if the
+    // view has turned far enough since the queue was last sorted that it
+    // should be reprioritised.
+    bool setViewDirection(float dirX, float dirY, float dirZ);
+
+    // Urgency of chunk (x, y, z) for loading and meshing; lower is sooner.
+    // Squared distance from the window centre, scaled from 1x for chunks
+    // straight ahead to 3x for chunks straight behind.
+    float getStreamingPriority(int x, int y, int z) const;
+
+    void queueLoad(int x, int y, int z);
+
+    // Rescore the queue for the current centre and view. Requests that are
+    // no longer waiting (not in `pendingChunks`, or already given a chunk)
+    // are dropped.
+    void reprioritiseLoadQueue(const FlatHashMap<Chunk*>& pendingChunks);
+
+    // Pop waiting requests, most urgent first, and hand them to
+    // startLoad(x, y, z), which returns true if it started a generation
+    // job. Stops once `jobBudget` jobs (0 = unlimited) or `jobSlots` jobs
+    // have been started.
+    void dispatchLoadRequests(const FlatHashMap<Chunk*>& pendingChunks,
+                              unsigned int jobBudget, size_t jobSlots,
+                              const std::function<bool(int, int, int)>& startLoad);
+
+    size_t getQueuedLoadCount() const { return loadQueue.size(); }
+
+private:
+    // Window state: centre chunk of the last update and offset tables for
+    // its radius. The shell tables are indexed by the step between centres
+    // (each component -1..1, see stepIndex()).
+    static const int STREAM_STEP_COUNT = 27;
+    bool active;
+    int centerX, centerY, centerZ;
+    int horizontalRadius, verticalRadius;
+    std::vector<ChunkOffset> loadOffsets;  // Whole load window, nearest first
+    std::vector<ChunkOffset> enterShells[STREAM_STEP_COUNT];  // Relative to the new centre
+    std::vector<ChunkOffset> leaveShells[STREAM_STEP_COUNT];  // Relative to the old centre
+
+    struct LoadRequest {
+        float priority;
+        int x, y, z;
+    };
+    std::vector<LoadRequest> loadQueue;
+    float viewDirX, viewDirY, viewDirZ;        // Normalised
+    float queueViewX, queueViewY, queueViewZ;  // Direction the queue was last sorted for
+
+    // Heap order: the smallest priority ends up on top
+    static bool isLater(const LoadRequest& a, const LoadRequest& b) { return a.priority > b.priority; }
+    static bool isWaiting(const FlatHashMap<Chunk*>& pendingChunks, int x, int y, int z);
+    void buildStreamingTables(int horizontalDistance, int verticalDistance);
+    static int stepIndex(int dx, int dy, int dz) { return (dx + 1) * 9 + (dy + 1) * 3 + (dz + 1); }
+};
+
+#endif // CHUNK_STREAMER_H
@@ -0,0 +1,160 @@
+#include "heightmap_cache.h"
+#include "noise.h"
+#include "terrain_config.h"
+#include "chunk_key.h"
+#include <algorithm>
+#include <limits>
+
+HeightmapCache::HeightmapCache()
+    : capacity(0), head(NO_ENTRY), tail(NO_ENTRY) {
+}
+
+void HeightmapCache::setCapacity(size_t columns) {
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = columns;
+    entries.clear();
+    entries.reserve(columns);
+    entryIndices.clear();
+    entryIndices.reserve(columns);
+    head = tail = NO_ENTRY;
+}
+
+void HeightmapCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    entryIndices.clear();
+    head = tail = NO_ENTRY;
+}
+
+void HeightmapCache::getColumn(int chunkX, int chunkZ, ColumnHeights& out) {
+    const uint64_t key = ChunkKeys::pack(chunkX, 0, chunkZ);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const uint32_t* index = entryIndices.find(key);
+        if (index) {
+            const uint32_t hit = *index;
+            unlink(hit);
+            pushFront(hit);
+            out = entries[hit].columns;
+            return;
+        }
+    }
+
+    // Compute without holding the lock. Two workers may race on the same
+    // column; both get identical heights and the second insert is dropped.
+    computeColumn(chunkX, chunkZ, out);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0 || entryIndices.contains(key)) {
+        return;
+    }
+
+    uint32_t slot;
+    if (entries.size() < capacity) {
+        slot = static_cast<uint32_t>(entries.size());
+        entries.push_back(Entry());
+    } else {
+        // Reuse the least recently used entry
+        slot = tail;
+        unlink(slot);
+        entryIndices.erase(entries[slot].key);
+    }
+
+    entries[slot].key = key;
+    entries[slot].columns = out;
+    entryIndices[key] = slot;
+    pushFront(slot);
+}
+
+int HeightmapCache::getHeightAt(int worldX, int worldZ) {
+    const int chunkX = worldToChunk(worldX);
+    const int chunkZ = worldToChunk(worldZ);
+
+    ColumnHeights columns;
+    getColumn(chunkX, chunkZ, columns);
+    return columns.heights[(worldX - chunkX * CHUNK_SIZE) + (worldZ - chunkZ * CHUNK_SIZE) * CHUNK_SIZE];
+}
+
+void HeightmapCache::computeColumn(int chunkX, int chunkZ, ColumnHeights& out) {
+    // Create noise generator with a fixed seed for consistent terrain
+    static PerlinNoise noise(TerrainConfig::NOISE_SEED);
+
+    // Sample all 256 columns in one batch (SIMD where available)
+    float noiseValues[CHUNK_AREA];
+    noise.octaveNoiseGrid(chunkX * CHUNK_SIZE, chunkZ * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE,
+                          TerrainConfig::SCALE, TerrainConfig::OCTAVES,
+                          TerrainConfig::PERSISTENCE, noiseValues);
+
+    out.minHeight = std::numeric_limits<int>::max();
+    out.maxHeight = std::numeric_limits<int>::min();
+
+    for (int i = 0; i < CHUNK_AREA; ++i) {
+        // Convert noise value from [-1, 1] to terrain height
+        int terrainHeight = TerrainConfig::BASE_HEIGHT +
+                            static_cast<int>(noiseValues[i] * TerrainConfig::HEIGHT_MULTIPLIER);
+
+        out.heights[i] = terrainHeight;
+        out.minHeight = std::min(out.minHeight, terrainHeight);
+        out.maxHeight = std::max(out.maxHeight, terrainHeight);
+    }
+}
+
+ChunkContent HeightmapCache::classify(int chunkY, int minHeight, int maxHeight) {
+    const int chunkBottom = chunkY * CHUNK_SIZE;
+    const int chunkTop = chunkBottom + CHUNK_SIZE - 1;
+
+    if (chunkBottom >= maxHeight) {
+        // Entirely above the highest surface: sky
+        return CHUNK_CONTENT_AIR;
+    }
+    if (chunkTop < minHeight - TerrainConfig::SOIL_DEPTH) {
+        // Entirely below the lowest soil layer: solid stone
+        return CHUNK_CONTENT_STONE;
+    }
+    return CHUNK_CONTENT_MIXED;
+}
+
+ChunkContent HeightmapCache::classifyLayer(int chunkY) {
+    return classify(chunkY, TerrainConfig::MIN_HEIGHT, TerrainConfig::MAX_HEIGHT);
+}
+
+ChunkContent HeightmapCache::classifyChunk(int chunkX, int chunkY, int chunkZ) {
+    const ChunkContent content = classifyLayer(chunkY);
+    if (content != CHUNK_CONTENT_MIXED) {
+        return content;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const uint32_t* index = entryIndices.find(ChunkKeys::pack(chunkX, 0, chunkZ));
+    if (!index) {
+        return CHUNK_CONTENT_MIXED;
+    }
+    const ColumnHeights& columns = entries[*index].columns;
+    return classify(chunkY, columns.minHeight, columns.maxHeight);
+}
+
+void HeightmapCache::unlink(uint32_t index) {
+    Entry& entry = entries[index];
+    if (entry.prev != NO_ENTRY) {
+        entries[entry.prev].next = entry.next;
+    } else {
+        head = entry.next;
+    }
+    if (entry.next != NO_ENTRY) {
+        entries[entry.next].prev = entry.prev;
+    } else {
+        tail = entry.prev;
+    }
+}
+
+void HeightmapCache::pushFront(uint32_t index) {
+    Entry& entry = entries[index];
+    entry.prev = NO_ENTRY;
+    entry.next = head;
+    if (head != NO_ENTRY) {
+        entries[head].prev = index;
+    } else {
+        tail = index;
+    }
+    head = index;
+}
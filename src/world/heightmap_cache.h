@@ -0,0 +1,82 @@
+#ifndef HEIGHTMAP_CACHE_H
+#define HEIGHTMAP_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include "chunk.h"
+#include "utils/flat_hash_map.h"
+
+// Terrain surface heights of one chunk column: every vertically stacked
+// chunk at (chunkX, chunkZ) shares them
+struct ColumnHeights {
+    int heights[CHUNK_AREA];  // Indexed [x + z * CHUNK_SIZE]
+    int minHeight;
+    int maxHeight;
+};
+
+// What a chunk contains, as far as surface height bounds can tell
+enum ChunkContent {
+    CHUNK_CONTENT_MIXED = 0,  // May contain the surface: has to be generated
+    CHUNK_CONTENT_AIR = 1,    // Entirely above the surface
+    CHUNK_CONTENT_STONE = 2   // Entirely below the soil layer
+};
+
+// LRU cache of column heightmaps
+//
+// Terrain height is a 2D function, so generating a chunk only needs the
+// noise of its column; the cache lets all chunks stacked in a column share
+// one evaluation. Capacity is set from the streaming window (see
+// ChunkManager), so columns are evicted once the camera has moved away from
+// them. Safe to use from the generation workers and the main thread at once.
+class HeightmapCache {
+public:
+    HeightmapCache();
+
+    // Maximum number of cached columns. Changing it empties the cache.
+    void setCapacity(size_t columns);
+    void clear();
+
+    // Copy the heights of column (chunkX, chunkZ), computing them on a miss
+    void getColumn(int chunkX, int chunkZ, ColumnHeights& out);
+
+    // Surface height of the voxel column containing (worldX, worldZ): the
+    // world Y just above its top solid voxel
+    int getHeightAt(int worldX, int worldZ);
+
+    // Evaluate the terrain noise for a column without caching
+    static void computeColumn(int chunkX, int chunkZ, ColumnHeights& out);
+
+    // Classify chunk layer `chunkY` given the surface heights of its column
+    static ChunkContent classify(int chunkY, int minHeight, int maxHeight);
+
+    // Classify a chunk layer from the world-wide height bounds alone
+    // (TerrainConfig::MIN_HEIGHT/MAX_HEIGHT), without sampling any noise
+    static ChunkContent classifyLayer(int chunkY);
+
+    // Classify a chunk from its column's cached bounds, or from the world
+    // bounds if the column is not cached. Never computes a column.
+    ChunkContent classifyChunk(int chunkX, int chunkY, int chunkZ);
+
+private:
+    static const uint32_t NO_ENTRY = ~uint32_t(0);
+
+    // Entries form a doubly linked list from most to least recently used
+    struct Entry {
+        uint64_t key;
+        uint32_t prev, next;
+        ColumnHeights columns;
+    };
+
+    std::mutex mutex;
+    size_t capacity;
+    std::vector<Entry> entries;
+    FlatHashMap<uint32_t> entryIndices;
+    uint32_t head, tail;
+
+    void unlink(uint32_t index);
+    void pushFront(uint32_t index);
+};
+
+#endif // HEIGHTMAP_CACHE_H
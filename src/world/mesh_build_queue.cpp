@@ -0,0 +1,62 @@
+#include "mesh_build_queue.h"
+#include "mesh_generator.h"
+#include "utils/thread_pool.h"
+
+MeshBuildQueue::MeshBuildQueue() : pool(nullptr), inFlightCount(0), algorithm(MESH_ALGORITHM_BINARY) {
+}
+
+MeshBuildQueue::~MeshBuildQueue() {
+    cleanup();
+}
+
+void MeshBuildQueue::init(unsigned int workerCount) {
+    pool = new ThreadPool();
+    pool->init(workerCount);
+}
+
+void MeshBuildQueue::cleanup() {
+    if (pool) {
+        pool->cleanup();
+        delete pool;
+        pool = nullptr;
+    }
+    completedResults.clear();
+    inFlightCount = 0;
+}
+
+void MeshBuildQueue::submit(const Chunk& chunk, const ChunkBorders& borders) {
+    // Snapshot everything the job needs; it never touches the chunk itself
+    PaletteStorage snapshot = chunk.getVoxelStorage();
+    const int chunkX = chunk.getPosX();
+    const int chunkY = chunk.getPosY();
+    const int chunkZ = chunk.getPosZ();
+    const uint64_t version = chunk.getVersion();
+    const MeshAlgorithm meshAlgorithm = algorithm;
+
+    ++inFlightCount;
+    pool->submit([this, snapshot, borders, chunkX, chunkY, chunkZ, version, meshAlgorithm]() {
+        MeshBuildResult result;
+        result.chunkX = chunkX;
+        result.chunkY = chunkY;
+        result.chunkZ = chunkZ;
+        result.version = version;
+        MeshGenerator::generateMesh(snapshot, &borders, result.vertices, result.faceRanges, meshAlgorithm);
+        result.connectivity = ChunkConnectivity::compute(snapshot);
+
+        std::lock_guard<std::mutex> lock(completedMutex);
+        completedResults.push_back(std::move(result));
+    });
+}
+
+void MeshBuildQueue::collectResults(std::vector<MeshBuildResult>& results) {
+    std::lock_guard<std::mutex> lock(completedMutex);
+    inFlightCount -= completedResults.size();
+    if (results.empty()) {
+        results.swap(completedResults);
+        return;
+    }
+    for (MeshBuildResult& result : completedResults) {
+        results.push_back(std::move(result));
+    }
+    completedResults.clear();
+}
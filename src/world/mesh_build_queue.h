@@ -0,0 +1,60 @@
+#ifndef MESH_BUILD_QUEUE_H
+#define MESH_BUILD_QUEUE_H
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include "chunk.h"
+#include "chunk_connectivity.h"
+#include "mesh_generator.h"
+#include "graphics/mesh.h"
+
+class ThreadPool;
+
+// CPU-side mesh produced by a worker, waiting to be uploaded by the renderer
+struct MeshBuildResult {
+    int chunkX, chunkY, chunkZ;
+    uint64_t version;  // Chunk::getVersion() at the time of the snapshot
+    std::vector<Vertex> vertices;  // Quad list, see QUAD_INDEX_PATTERN in mesh.h
+    MeshFaceRanges faceRanges;
+    ChunkConnectivityMask connectivity;  // Face-to-face visibility through the chunk
+};
+
+// Builds chunk meshes on a worker pool
+//
+// submit() copies the chunk's voxel storage and its neighbours' border
+// layers on the calling thread, so chunks may be edited or unloaded while
+// the job runs. Results come back in completion order through
+// collectResults(); the caller decides whether a result is still current by
+// comparing its version with the live chunk.
+class MeshBuildQueue {
+public:
+    MeshBuildQueue();
+    ~MeshBuildQueue();
+
+    // Start the mesh workers (0 = hardware concurrency)
+    void init(unsigned int workerCount = 0);
+    void cleanup();
+
+    void submit(const Chunk& chunk, const ChunkBorders& borders);
+
+    // Mesher used by jobs submitted from now on (see MeshAlgorithm)
+    void setAlgorithm(MeshAlgorithm meshAlgorithm) { algorithm = meshAlgorithm; }
+    MeshAlgorithm getAlgorithm() const { return algorithm; }
+
+    // Append all finished results to `results` (main thread only)
+    void collectResults(std::vector<MeshBuildResult>& results);
+
+    // Jobs submitted but not yet collected
+    size_t getInFlightCount() const { return inFlightCount; }
+
+private:
+    ThreadPool* pool;
+    size_t inFlightCount;
+    MeshAlgorithm algorithm;
+
+    std::mutex completedMutex;
+    std::vector<MeshBuildResult> completedResults;
+};
+
+#endif // MESH_BUILD_QUEUE_H
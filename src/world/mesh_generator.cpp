@@ -1,40 +1,158 @@
 #include "mesh_generator.h"
 #include <cstring> // for memset
-#include <algorithm> // for std::any_of
+#include <algorithm>
+#include <bitset>
 
-void MeshGenerator::generateChunkMesh(const Chunk& chunk, 
-                                     std::vector<Vertex>& vertices, 
-                                     std::vector<uint32_t>& indices) {
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// The binary mesher keeps one bit per voxel along a chunk axis
+static_assert(CHUNK_SIZE <= 64, "Binary mesher columns are 64-bit masks");
+
+// Vertex positions run 0..CHUNK_SIZE inclusive in 5-bit fields, which is
+// also what lets emitQuad add offsets without carries crossing fields. The
+// mesh quad bound in mesh.h is written out for 16^3 chunks.
+static_assert(CHUNK_SIZE < 32, "packed vertex coordinates are 5 bits");
+static_assert(MAX_MESH_QUADS == 3 * CHUNK_VOLUME, "MAX_MESH_QUADS must match the chunk size");
+
+// Index of the lowest set bit (bits must be non-zero)
+static inline int countTrailingZeros(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+// Number of consecutive set bits starting at bit 0
+static inline int countTrailingOnes(uint64_t bits) {
+    return bits == ~uint64_t(0) ? 64 : countTrailingZeros(~bits);
+}
+
+// Bits [first, first + count)
+static inline uint64_t bitRange(int first, int count) {
+    return (count >= 64 ? ~uint64_t(0) : ((uint64_t(1) << count) - 1)) << first;
+}
+
+// Quad corner tables for emitQuad, per face direction (ChunkFace order).
+// Corner k lies QUAD_CORNER_U[f][k] * width along the face's u axis and
+// QUAD_CORNER_V[f][k] * height along its v axis from the quad's origin, so
+// negative faces run their corners the other way round to keep the winding
+// clockwise from the front. Texture coordinates are the same for every
+// direction.
+constexpr int QUAD_U_AXIS[3] = {1, 0, 0};  // Y, X, X for axes 0, 1, 2
+constexpr int QUAD_V_AXIS[3] = {2, 2, 1};  // Z, Z, Y for axes 0, 1, 2
+constexpr uint32_t QUAD_CORNER_U[FACE_COUNT][QUAD_VERTEX_COUNT] = {
+    {0, 1, 1, 0}, {0, 1, 1, 0}, {1, 0, 0, 1}, {0, 1, 1, 0}, {1, 0, 0, 1}, {0, 1, 1, 0}
+};
+constexpr uint32_t QUAD_CORNER_V[FACE_COUNT][QUAD_VERTEX_COUNT] = {
+    {1, 1, 0, 0}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}
+};
+constexpr uint32_t QUAD_TEXCOORD_U[QUAD_VERTEX_COUNT] = {0, 1, 1, 0};
+constexpr uint32_t QUAD_TEXCOORD_V[QUAD_VERTEX_COUNT] = {0, 0, 1, 1};
+
+// Bit offset of each axis in Vertex::position (see VertexPacking)
+constexpr int POSITION_AXIS_SHIFT[3] = {0, 5, 10};
+
+void MeshGenerator::generateChunkMesh(const Chunk& chunk, std::vector<Vertex>& vertices,
+                                      MeshAlgorithm algorithm) {
+    MeshFaceRanges faceRanges;
+    generateMesh(chunk.getVoxelStorage(), nullptr, vertices, faceRanges, algorithm);
+}
+
+void MeshGenerator::generateMesh(const PaletteStorage& voxels,
+                                 const ChunkBorders* borders,
+                                 std::vector<Vertex>& vertices,
+                                 MeshFaceRanges& faceRanges,
+                                 MeshAlgorithm algorithm) {
     vertices.clear();
-    indices.clear();
+    std::fill(faceRanges.start, faceRanges.start + MeshFaceRanges::DIRECTION_COUNT + 1, 0u);
     
-    // Early exit optimization: check if chunk has any solid voxels
-    const auto& voxels = chunk.getVoxels();
-    bool hasAnyVoxel = std::any_of(voxels.begin(), voxels.end(), 
-                                    [](const Voxel& v) { return v.getType() != 0; });
+    // Early exit: all-air chunks have nothing to draw. All-stone chunks are
+    // classified as such only below the soil layers of every column, so
+    // without neighbour data they are assumed to be buried.
+    if (voxels.isUniform()) {
+        if (voxels.getUniformType() == VoxelType::AIR || !borders || isHidden(voxels, *borders)) {
+            return;
+        }
+    }
     
-    // Skip meshing entirely if chunk is completely empty
-    if (!hasAnyVoxel) {
+    if (algorithm != MESH_ALGORITHM_REFERENCE) {
+        generateMeshBinary(voxels, borders, vertices, faceRanges, algorithm == MESH_ALGORITHM_BINARY);
         return;
     }
     
-    // Reserve space for vertices and indices to reduce reallocations
-    // Estimate: worst case is 6 faces per voxel, 4 vertices per face, 6 indices per face
+    // Reserve space for vertices to reduce reallocations
+    // Estimate: worst case is 6 faces per voxel, 4 vertices per face
     // In practice, greedy meshing reduces this significantly, but we reserve a reasonable amount
     vertices.reserve(CHUNK_SIZE * CHUNK_SIZE * 8);  // ~2048 vertices for 16^3 chunk
-    indices.reserve(CHUNK_SIZE * CHUNK_SIZE * 12);  // ~3072 indices
     
-    // Get chunk world position offset
-    int chunkOffsetX = chunk.getPosX() * CHUNK_SIZE;
-    int chunkOffsetY = chunk.getPosY() * CHUNK_SIZE;
-    int chunkOffsetZ = chunk.getPosZ() * CHUNK_SIZE;
-
+    // Decode once into the padded view; all mask building reads this flat array
+    uint8_t padded[PADDED_VOLUME];
+    buildPaddedView(voxels, borders, padded);
+    
     // Apply greedy meshing for each of the three axes
     // axis 0: X-axis (generates faces perpendicular to X)
     // axis 1: Y-axis (generates faces perpendicular to Y)
     // axis 2: Z-axis (generates faces perpendicular to Z)
+    // Negative-direction quads go straight to the output and positive ones
+    // are appended after them, giving one vertex range per face direction
+    std::vector<Vertex> frontVertices;
+    frontVertices.reserve(CHUNK_SIZE * CHUNK_SIZE * 2);
     for (int axis = 0; axis < 3; ++axis) {
-        greedyMeshAxis(chunk, vertices, indices, axis, chunkOffsetX, chunkOffsetY, chunkOffsetZ);
+        frontVertices.clear();
+        faceRanges.start[axis * 2] = static_cast<uint32_t>(vertices.size());
+        greedyMeshAxis(padded, vertices, frontVertices, axis);
+        faceRanges.start[axis * 2 + 1] = static_cast<uint32_t>(vertices.size());
+        vertices.insert(vertices.end(), frontVertices.begin(), frontVertices.end());
+    }
+    faceRanges.start[MeshFaceRanges::DIRECTION_COUNT] = static_cast<uint32_t>(vertices.size());
+}
+
+bool MeshGenerator::isHidden(const PaletteStorage& voxels, const ChunkBorders& borders) {
+    if (!voxels.isUniform()) {
+        return false;
+    }
+    return voxels.getUniformType() == VoxelType::AIR || borders.isSolid();
+}
+
+void MeshGenerator::buildPaddedView(const PaletteStorage& voxels, const ChunkBorders* borders,
+                                    uint8_t* padded) {
+    // Edges and corners of the padding are never read (only one coordinate
+    // steps outside the chunk at a time); leave them as air
+    std::memset(padded, 0, PADDED_VOLUME);
+    
+    uint8_t types[CHUNK_VOLUME];
+    voxels.unpack(types);
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            std::memcpy(&padded[1 + (y + 1) * PADDED_SIZE + (z + 1) * PADDED_SIZE * PADDED_SIZE],
+                        &types[y * CHUNK_SIZE + z * CHUNK_AREA], CHUNK_SIZE);
+        }
+    }
+    
+    if (!borders) {
+        return;
+    }
+    
+    // Scatter each neighbour layer into its side of the padding
+    for (int face = 0; face < FACE_COUNT; ++face) {
+        const int axis = face / 2;
+        const int slice = (face % 2 == 0) ? -1 : CHUNK_SIZE;
+        const uint8_t* layer = borders->layers[face];
+        for (int b = 0; b < CHUNK_SIZE; ++b) {
+            for (int a = 0; a < CHUNK_SIZE; ++a) {
+                int p[3];
+                p[axis] = slice;
+                p[axis == 0 ? 1 : 0] = a;
+                p[axis == 2 ? 1 : 2] = b;
+                padded[(p[0] + 1) + (p[1] + 1) * PADDED_SIZE + (p[2] + 1) * PADDED_SIZE * PADDED_SIZE] =
+                    layer[a + b * CHUNK_SIZE];
+            }
+        }
     }
 }
 
@@ -43,9 +161,7 @@ bool MeshGenerator::isVoxelSolid(const Chunk& chunk, int x, int y, int z) {
         return false; // Out of bounds, treat as air
     }
     
-    // Index calculation matches chunk voxel storage order
-    int index = x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE;
-    return chunk.getVoxels()[index].getType() != 0;
+    return chunk.getVoxelType(x, y, z) != VoxelType::AIR;
 }
 
 uint8_t MeshGenerator::getVoxelType(const Chunk& chunk, int x, int y, int z) {
@@ -53,21 +169,16 @@ uint8_t MeshGenerator::getVoxelType(const Chunk& chunk, int x, int y, int z) {
         return 0; // Out of bounds, treat as air
     }
     
-    int index = x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE;
-    return chunk.getVoxels()[index].getType();
+    return chunk.getVoxelType(x, y, z);
 }
 
-void MeshGenerator::greedyMeshAxis(const Chunk& chunk,
-                                   std::vector<Vertex>& vertices,
-                                   std::vector<uint32_t>& indices,
-                                   int axis,
-                                   int chunkOffsetX, int chunkOffsetY, int chunkOffsetZ) {
+void MeshGenerator::greedyMeshAxis(const uint8_t* padded,
+                                   std::vector<Vertex>& backVertices,
+                                   std::vector<Vertex>& frontVertices,
+                                   int axis) {
     // For greedy meshing, we sweep through slices perpendicular to the axis
     // and merge adjacent faces with the same voxel type
     
-    // Cache voxels array for faster access (avoids repeated function calls)
-    const auto& voxels = chunk.getVoxels();
-    
     // axis 0 = X, axis 1 = Y, axis 2 = Z
     // u and v are the two axes perpendicular to the main axis
     // For consistent texture mapping, u and v are chosen to align with standard orientations:
@@ -97,18 +208,21 @@ void MeshGenerator::greedyMeshAxis(const Chunk& chunk,
                 // Get voxel types on both sides of the slice
                 // voxelType1 is the voxel at current position
                 // voxelType2 is the voxel in the +axis direction
-                uint8_t voxelType1 = (x[axis] >= 0) ? getVoxelTypeDirect(voxels, x[0], x[1], x[2]) : 0;
+                // On the first and last slice one of them comes from a neighbour
+                uint8_t voxelType1 = getVoxelTypeDirect(padded, x[0], x[1], x[2]);
                 
                 int x2[3] = {x[0], x[1], x[2]};
                 x2[axis]++;
-                uint8_t voxelType2 = (x2[axis] < CHUNK_SIZE) ? getVoxelTypeDirect(voxels, x2[0], x2[1], x2[2]) : 0;
+                uint8_t voxelType2 = getVoxelTypeDirect(padded, x2[0], x2[1], x2[2]);
                 
                 // If the voxels are different, we have an exposed face
-                // We store the type of the solid voxel in the mask
-                if (voxelType1 != 0 && voxelType2 == 0) {
+                // We store the type of the solid voxel in the mask. A face
+                // belongs to the chunk that owns its solid voxel, so the
+                // neighbour's faces are left to the neighbour.
+                if (voxelType1 != 0 && voxelType2 == 0 && x[axis] >= 0) {
                     // Face pointing in positive axis direction
                     mask[x[u] + x[v] * CHUNK_SIZE] = voxelType1;
-                } else if (voxelType1 == 0 && voxelType2 != 0) {
+                } else if (voxelType1 == 0 && voxelType2 != 0 && x2[axis] < CHUNK_SIZE) {
                     // Face pointing in negative axis direction
                     // We use bit 7 to indicate back faces
                     mask[x[u] + x[v] * CHUNK_SIZE] = voxelType2 | 0x80;
@@ -154,11 +268,11 @@ void MeshGenerator::greedyMeshAxis(const Chunk& chunk,
                     int quadWidth = width;  // extends in u direction
                     int quadHeight = height; // extends in v direction
                     
-                    addQuad(vertices, indices,
+                    addQuad(backFace ? backVertices : frontVertices,
                            quadPos[0], quadPos[1], quadPos[2],
                            quadWidth, quadHeight,
                            axis, backFace,
-                           chunkOffsetX, chunkOffsetY, chunkOffsetZ);
+                           static_cast<uint8_t>(currentMask & 0x7F));
                     
                     // Clear the mask in the merged region
                     for (int l = 0; l < height; ++l) {
@@ -179,18 +293,236 @@ void MeshGenerator::greedyMeshAxis(const Chunk& chunk,
     }
 }
 
+void MeshGenerator::generateMeshBinary(const PaletteStorage& voxels,
+                                       const ChunkBorders* borders,
+                                       std::vector<Vertex>& vertices,
+                                       MeshFaceRanges& faceRanges,
+                                       bool templatedEmission) {
+    uint8_t types[CHUNK_VOLUME];
+    voxels.unpack(types);
+    
+    // Give each solid voxel type in the chunk a dense index, and mark solid
+    // voxels in three sets of columns: columns[axis][u + v * CHUNK_SIZE]
+    // has bit k set if the voxel at coordinate k along `axis` is solid
+    uint8_t typeIndices[256];
+    uint8_t typeIds[256];
+    int typeCount = 0;
+    std::memset(typeIndices, 0xFF, sizeof(typeIndices));
+    
+    uint64_t columns[3][CHUNK_AREA];
+    std::memset(columns, 0, sizeof(columns));
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            const uint8_t* row = &types[y * CHUNK_SIZE + z * CHUNK_AREA];
+            uint64_t rowBits = 0;
+            for (int x = 0; x < CHUNK_SIZE; ++x) {
+                const uint8_t type = row[x];
+                if (type == VoxelType::AIR) {
+                    continue;
+                }
+                if (typeIndices[type] == 0xFF) {
+                    typeIndices[type] = static_cast<uint8_t>(typeCount);
+                    typeIds[typeCount++] = type;
+                }
+                rowBits |= uint64_t(1) << x;
+                columns[1][x + z * CHUNK_SIZE] |= uint64_t(1) << y;
+                columns[2][x + y * CHUNK_SIZE] |= uint64_t(1) << z;
+            }
+            columns[0][y + z * CHUNK_SIZE] = rowBits;
+        }
+    }
+    
+    // Visible faces of each direction, sorted by plane (the face's position
+    // along the axis), row v and voxel type: bit u of
+    // faceRows[(plane * CHUNK_SIZE + v) * typeCount + type]. Quads are built
+    // in quadVertices and copied out once at the end. Both buffers are kept
+    // per worker thread and only grow, so steady-state meshing does not
+    // allocate beyond the exactly sized output.
+    thread_local std::vector<uint64_t> faceRows;
+    thread_local std::vector<Vertex> quadVertices;
+    const int planeRowCount = CHUNK_SIZE * typeCount;
+    faceRows.assign(static_cast<size_t>(CHUNK_SIZE + 1) * planeRowCount, 0);
+    size_t quadVertexCount = 0;
+    
+    for (int axis = 0; axis < 3; ++axis) {
+        const int u = QUAD_U_AXIS[axis];
+        const int v = QUAD_V_AXIS[axis];
+        
+        for (int side = 0; side < 2; ++side) {
+            const bool backFace = (side == 0);
+            const int face = axis * 2 + side;  // ChunkFace order
+            
+            // A face is visible where a solid voxel has air next to it in
+            // the face's direction. Neighbour chunks supply the bit beyond
+            // each end of the column; without them it counts as air.
+            const uint8_t* border = borders ? borders->layers[face] : nullptr;
+            std::fill(faceRows.begin(), faceRows.end(), 0);
+            size_t faceCount = 0;
+            for (int column = 0; column < CHUNK_AREA; ++column) {
+                const uint64_t solid = columns[axis][column];
+                if (solid == 0) {
+                    continue;
+                }
+                const uint64_t beyond = (border && border[column] != VoxelType::AIR) ? 1 : 0;
+                uint64_t visible = backFace ?
+                    solid & ~((solid << 1) | beyond) :
+                    solid & ~((solid >> 1) | (beyond << (CHUNK_SIZE - 1)));
+                
+                const int cu = column % CHUNK_SIZE;
+                const int cv = column / CHUNK_SIZE;
+                faceCount += std::bitset<64>(visible).count();
+                while (visible) {
+                    const int k = countTrailingZeros(visible);
+                    visible &= visible - 1;
+                    
+                    int p[3];
+                    p[axis] = k;
+                    p[u] = cu;
+                    p[v] = cv;
+                    const uint8_t type = types[p[0] + p[1] * CHUNK_SIZE + p[2] * CHUNK_AREA];
+                    
+                    // Back faces lie on the voxel's lower side, front faces
+                    // on its upper side
+                    const int plane = backFace ? k : k + 1;
+                    faceRows[plane * planeRowCount + cv * typeCount + typeIndices[type]] |= uint64_t(1) << cu;
+                }
+            }
+            
+            faceRanges.start[face] = static_cast<uint32_t>(quadVertexCount);
+            if (!templatedEmission) {
+                // Baseline: one addQuad call per quad, appended to the
+                // scratch buffer
+                quadVertices.resize(quadVertexCount);
+                for (int plane = 0; plane <= CHUNK_SIZE; ++plane) {
+                    greedyMeshPlaneBitsAddQuad(faceRows.data() + plane * planeRowCount, typeCount, typeIds,
+                                               quadVertices, axis, plane, backFace);
+                }
+                quadVertexCount = quadVertices.size();
+                continue;
+            }
+            
+            // Every quad covers at least one face, so the direction's quads
+            // fit into a span of one quad per face; the next direction
+            // starts where this one's quads end
+            const size_t spanEnd = quadVertexCount + faceCount * QUAD_VERTEX_COUNT;
+            if (quadVertices.size() < spanEnd) {
+                quadVertices.resize(spanEnd);
+            }
+            Vertex* out = quadVertices.data() + quadVertexCount;
+            for (int plane = 0; plane <= CHUNK_SIZE; ++plane) {
+                uint64_t* rows = faceRows.data() + plane * planeRowCount;
+                switch (face) {
+                    case FACE_NEG_X: out = greedyMeshPlaneBits<FACE_NEG_X>(rows, typeCount, typeIds, plane, out); break;
+                    case FACE_POS_X: out = greedyMeshPlaneBits<FACE_POS_X>(rows, typeCount, typeIds, plane, out); break;
+                    case FACE_NEG_Y: out = greedyMeshPlaneBits<FACE_NEG_Y>(rows, typeCount, typeIds, plane, out); break;
+                    case FACE_POS_Y: out = greedyMeshPlaneBits<FACE_POS_Y>(rows, typeCount, typeIds, plane, out); break;
+                    case FACE_NEG_Z: out = greedyMeshPlaneBits<FACE_NEG_Z>(rows, typeCount, typeIds, plane, out); break;
+                    default:         out = greedyMeshPlaneBits<FACE_POS_Z>(rows, typeCount, typeIds, plane, out); break;
+                }
+            }
+            quadVertexCount = static_cast<size_t>(out - quadVertices.data());
+        }
+    }
+    faceRanges.start[MeshFaceRanges::DIRECTION_COUNT] = static_cast<uint32_t>(quadVertexCount);
+    vertices.assign(quadVertices.begin(), quadVertices.begin() + quadVertexCount);
+}
+
+// Greedy-merge the row masks of one plane (typeCount masks per row,
+// consumed in the process), calling emit(u, v, width, height, typeIndex)
+// for each quad. Quads start at the first remaining face of a row, scanning
+// rows in order, and grow along u first, then along v: the same order and
+// the same shapes as greedyMeshAxis.
+template <typename Emit>
+static inline void mergePlaneRows(uint64_t* rows, int typeCount, Emit emit) {
+    for (int j = 0; j < CHUNK_SIZE; ++j) {
+        uint64_t* row = &rows[j * typeCount];
+        uint64_t remaining = 0;
+        for (int t = 0; t < typeCount; ++t) {
+            remaining |= row[t];
+        }
+        
+        while (remaining) {
+            const int i = countTrailingZeros(remaining);
+            int t = 0;
+            while (!(row[t] & (uint64_t(1) << i))) {
+                ++t;
+            }
+            
+            // Width: the run of same-type faces from i
+            const int width = countTrailingOnes(row[t] >> i);
+            const uint64_t span = bitRange(i, width);
+            row[t] &= ~span;
+            remaining &= ~span;
+            
+            // Height: following rows covering the whole span with this type
+            int height = 1;
+            for (; j + height < CHUNK_SIZE; ++height) {
+                uint64_t& next = rows[(j + height) * typeCount + t];
+                if ((next & span) != span) {
+                    break;
+                }
+                next &= ~span;
+            }
+            
+            emit(i, j, width, height, t);
+        }
+    }
+}
+
+template <int Face>
+Vertex* MeshGenerator::greedyMeshPlaneBits(uint64_t* rows, int typeCount, const uint8_t* typeIds,
+                                           int plane, Vertex* out) {
+    constexpr int axis = Face / 2;
+    mergePlaneRows(rows, typeCount, [&](int i, int j, int width, int height, int t) {
+        int quadPos[3];
+        quadPos[axis] = plane;
+        quadPos[QUAD_U_AXIS[axis]] = i;
+        quadPos[QUAD_V_AXIS[axis]] = j;
+        emitQuad<Face>(out, quadPos[0], quadPos[1], quadPos[2], width, height, typeIds[t]);
+        out += QUAD_VERTEX_COUNT;
+    });
+    return out;
+}
+
+void MeshGenerator::greedyMeshPlaneBitsAddQuad(uint64_t* rows, int typeCount, const uint8_t* typeIds,
+                                               std::vector<Vertex>& vertices,
+                                               int axis, int plane, bool backFace) {
+    mergePlaneRows(rows, typeCount, [&](int i, int j, int width, int height, int t) {
+        int quadPos[3];
+        quadPos[axis] = plane;
+        quadPos[QUAD_U_AXIS[axis]] = i;
+        quadPos[QUAD_V_AXIS[axis]] = j;
+        addQuad(vertices, quadPos[0], quadPos[1], quadPos[2], width, height, axis, backFace, typeIds[t]);
+    });
+}
+
+template <int Face>
+void MeshGenerator::emitQuad(Vertex* out, int x, int y, int z, int width, int height,
+                             uint8_t voxelType) {
+    constexpr int axis = Face / 2;
+    constexpr int uShift = POSITION_AXIS_SHIFT[QUAD_U_AXIS[axis]];
+    constexpr int vShift = POSITION_AXIS_SHIFT[QUAD_V_AXIS[axis]];
+    
+    // Corners only add whole-field offsets to the origin vertex; every
+    // coordinate stays within its field, so no carries cross fields
+    const Vertex origin = VertexPacking::pack(x, y, z, Face, 0, 0, voxelType);
+    const uint32_t uStep = static_cast<uint32_t>(width) << uShift;
+    const uint32_t vStep = static_cast<uint32_t>(height) << vShift;
+    const uint32_t texU = static_cast<uint32_t>(width);
+    const uint32_t texV = static_cast<uint32_t>(height) << 5;
+    for (uint32_t k = 0; k < QUAD_VERTEX_COUNT; ++k) {
+        out[k].position = origin.position + QUAD_CORNER_U[Face][k] * uStep + QUAD_CORNER_V[Face][k] * vStep;
+        out[k].surface = origin.surface + QUAD_TEXCOORD_U[k] * texU + QUAD_TEXCOORD_V[k] * texV;
+    }
+}
+
 void MeshGenerator::addQuad(std::vector<Vertex>& vertices,
-                           std::vector<uint32_t>& indices,
                            int x, int y, int z,
                            int width, int height,
                            int axis, bool backFace,
-                           int chunkOffsetX, int chunkOffsetY, int chunkOffsetZ) {
-    uint32_t baseIndex = static_cast<uint32_t>(vertices.size());
-    
-    // Apply chunk offset to get world coordinates
-    float fx = static_cast<float>(x + chunkOffsetX);
-    float fy = static_cast<float>(y + chunkOffsetY);
-    float fz = static_cast<float>(z + chunkOffsetZ);
+                           uint8_t voxelType) {
+    // Positions stay chunk-local; the chunk origin is added in the shader
+    const int face = axis * 2 + (backFace ? 0 : 1);  // ChunkFace: negative direction first
     
     Vertex v1, v2, v3, v4;
     
@@ -199,48 +531,49 @@ void MeshGenerator::addQuad(std::vector<Vertex>& vertices,
     // backFace = true means the face points in negative axis direction
     // width extends in the u direction, height in the v direction
     // Axis mappings: 0:(u=Y,v=Z), 1:(u=X,v=Z), 2:(u=X,v=Y)
+    // Texture coordinates count voxels, so they run 0..width and 0..height
     
     if (axis == 0) { // X-axis faces (perpendicular to X, lying in YZ plane)
         // u = 1 (Y), v = 2 (Z)
         // width extends in Y direction, height in Z direction
         if (!backFace) { // +X face (right)
-            v1 = {{fx, fy, fz}, {1, 0, 0}, {0, 0}};
-            v2 = {{fx, fy + width, fz}, {1, 0, 0}, {static_cast<float>(width), 0}};
-            v3 = {{fx, fy + width, fz + height}, {1, 0, 0}, {static_cast<float>(width), static_cast<float>(height)}};
-            v4 = {{fx, fy, fz + height}, {1, 0, 0}, {0, static_cast<float>(height)}};
+            v1 = VertexPacking::pack(x, y, z, face, 0, 0, voxelType);
+            v2 = VertexPacking::pack(x, y + width, z, face, width, 0, voxelType);
+            v3 = VertexPacking::pack(x, y + width, z + height, face, width, height, voxelType);
+            v4 = VertexPacking::pack(x, y, z + height, face, 0, height, voxelType);
         } else { // -X face (left)
-            v1 = {{fx, fy, fz + height}, {-1, 0, 0}, {0, 0}};
-            v2 = {{fx, fy + width, fz + height}, {-1, 0, 0}, {static_cast<float>(width), 0}};
-            v3 = {{fx, fy + width, fz}, {-1, 0, 0}, {static_cast<float>(width), static_cast<float>(height)}};
-            v4 = {{fx, fy, fz}, {-1, 0, 0}, {0, static_cast<float>(height)}};
+            v1 = VertexPacking::pack(x, y, z + height, face, 0, 0, voxelType);
+            v2 = VertexPacking::pack(x, y + width, z + height, face, width, 0, voxelType);
+            v3 = VertexPacking::pack(x, y + width, z, face, width, height, voxelType);
+            v4 = VertexPacking::pack(x, y, z, face, 0, height, voxelType);
         }
     } else if (axis == 1) { // Y-axis faces (perpendicular to Y, lying in XZ plane)
         // u = 0 (X), v = 2 (Z)
         // width extends in X direction, height in Z direction
         if (!backFace) { // +Y face (top)
-            v1 = {{fx, fy, fz}, {0, 1, 0}, {0, 0}};
-            v2 = {{fx + width, fy, fz}, {0, 1, 0}, {static_cast<float>(width), 0}};
-            v3 = {{fx + width, fy, fz + height}, {0, 1, 0}, {static_cast<float>(width), static_cast<float>(height)}};
-            v4 = {{fx, fy, fz + height}, {0, 1, 0}, {0, static_cast<float>(height)}};
+            v1 = VertexPacking::pack(x, y, z, face, 0, 0, voxelType);
+            v2 = VertexPacking::pack(x + width, y, z, face, width, 0, voxelType);
+            v3 = VertexPacking::pack(x + width, y, z + height, face, width, height, voxelType);
+            v4 = VertexPacking::pack(x, y, z + height, face, 0, height, voxelType);
         } else { // -Y face (bottom)
-            v1 = {{fx + width, fy, fz}, {0, -1, 0}, {0, 0}};
-            v2 = {{fx, fy, fz}, {0, -1, 0}, {static_cast<float>(width), 0}};
-            v3 = {{fx, fy, fz + height}, {0, -1, 0}, {static_cast<float>(width), static_cast<float>(height)}};
-            v4 = {{fx + width, fy, fz + height}, {0, -1, 0}, {0, static_cast<float>(height)}};
+            v1 = VertexPacking::pack(x + width, y, z, face, 0, 0, voxelType);
+            v2 = VertexPacking::pack(x, y, z, face, width, 0, voxelType);
+            v3 = VertexPacking::pack(x, y, z + height, face, width, height, voxelType);
+            v4 = VertexPacking::pack(x + width, y, z + height, face, 0, height, voxelType);
         }
     } else { // axis == 2, Z-axis faces (perpendicular to Z, lying in XY plane)
         // u = 0 (X), v = 1 (Y)
         // width extends in X direction, height in Y direction
         if (!backFace) { // +Z face (front)
-            v1 = {{fx, fy, fz}, {0, 0, 1}, {0, 0}};
-            v2 = {{fx + width, fy, fz}, {0, 0, 1}, {static_cast<float>(width), 0}};
-            v3 = {{fx + width, fy + height, fz}, {0, 0, 1}, {static_cast<float>(width), static_cast<float>(height)}};
-            v4 = {{fx, fy + height, fz}, {0, 0, 1}, {0, static_cast<float>(height)}};
+            v1 = VertexPacking::pack(x, y, z, face, 0, 0, voxelType);
+            v2 = VertexPacking::pack(x + width, y, z, face, width, 0, voxelType);
+            v3 = VertexPacking::pack(x + width, y + height, z, face, width, height, voxelType);
+            v4 = VertexPacking::pack(x, y + height, z, face, 0, height, voxelType);
         } else { // -Z face (back)
-            v1 = {{fx + width, fy, fz}, {0, 0, -1}, {0, 0}};
-            v2 = {{fx, fy, fz}, {0, 0, -1}, {static_cast<float>(width), 0}};
-            v3 = {{fx, fy + height, fz}, {0, 0, -1}, {static_cast<float>(width), static_cast<float>(height)}};
-            v4 = {{fx + width, fy + height, fz}, {0, 0, -1}, {0, static_cast<float>(height)}};
+            v1 = VertexPacking::pack(x + width, y, z, face, 0, 0, voxelType);
+            v2 = VertexPacking::pack(x, y, z, face, width, 0, voxelType);
+            v3 = VertexPacking::pack(x, y + height, z, face, width, height, voxelType);
+            v4 = VertexPacking::pack(x + width, y + height, z, face, 0, height, voxelType);
         }
     }
     
@@ -249,13 +582,7 @@ void MeshGenerator::addQuad(std::vector<Vertex>& vertices,
     vertices.push_back(v3);
     vertices.push_back(v4);
     
-    // Two triangles per quad with clockwise winding
-    // Pipeline expects VK_FRONT_FACE_CLOCKWISE due to Y-flip in projection matrix
-    indices.push_back(baseIndex);
-    indices.push_back(baseIndex + 2);
-    indices.push_back(baseIndex + 1);
-    
-    indices.push_back(baseIndex);
-    indices.push_back(baseIndex + 3);
-    indices.push_back(baseIndex + 2);
+    // No indices: the shared quad index buffer draws (v1, v3, v2) and
+    // (v1, v4, v3), clockwise as the pipeline expects (VK_FRONT_FACE_CLOCKWISE
+    // due to the Y-flip in the projection matrix)
 }
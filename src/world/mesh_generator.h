@@ -12,45 +12,101 @@
 //   chunk.load();  // Generate voxel data
 //   
 //   std::vector<Vertex> vertices;
-//   std::vector<uint32_t> indices;
-//   MeshGenerator::generateChunkMesh(chunk, vertices, indices);
+//   MeshGenerator::generateChunkMesh(chunk, vertices);
 //   
-//   Mesh* mesh = new Mesh(device, physicalDevice);
-//   mesh->createVertexBuffer(vertices);
-//   mesh->createIndexBuffer(indices);
+//   Mesh* mesh = new Mesh(geometryPool);
+//   mesh->create(vertices);
+//
+// Meshes are quad lists of four vertices per quad, drawn with the shared quad
+// index buffer (see QUAD_INDEX_PATTERN in mesh.h).
+
+// Mesher implementations. Both emit exactly the same quads in the same
+// order; REFERENCE is the original slice-by-slice greedy mesher.
+enum MeshAlgorithm {
+    MESH_ALGORITHM_REFERENCE = 0,
+    MESH_ALGORITHM_BINARY = 1,  // 64-bit occupancy columns, faces by shift and AND-NOT, bit-scan merging
+    MESH_ALGORITHM_BINARY_ADDQUAD = 2  // BINARY emitting each quad through addQuad; baseline for mesher_bench
+};
 
 class MeshGenerator {
 public:
-    static void generateChunkMesh(const Chunk& chunk, 
-                                  std::vector<Vertex>& vertices, 
-                                  std::vector<uint32_t>& indices);
+    static void generateChunkMesh(const Chunk& chunk, std::vector<Vertex>& vertices,
+                                  MeshAlgorithm algorithm = MESH_ALGORITHM_BINARY);
+    
+    // Mesh a copy of a chunk's voxel storage (safe to call from worker threads).
+    // Faces against a solid neighbour voxel in `borders` are culled; without
+    // borders everything outside the chunk counts as air. Vertex positions
+    // are chunk-local (see Vertex in mesh.h), and quads are grouped by face
+    // direction as described by `faceRanges`.
+    static void generateMesh(const PaletteStorage& voxels,
+                             const ChunkBorders* borders,
+                             std::vector<Vertex>& vertices,
+                             MeshFaceRanges& faceRanges,
+                             MeshAlgorithm algorithm = MESH_ALGORITHM_BINARY);
+    
+    // True if a chunk cannot produce any face: all air, or all solid and
+    // enclosed by solid neighbour voxels
+    static bool isHidden(const PaletteStorage& voxels, const ChunkBorders& borders);
 
 private:
     static bool isVoxelSolid(const Chunk& chunk, int x, int y, int z);
     static uint8_t getVoxelType(const Chunk& chunk, int x, int y, int z);
     
-    // Optimized version that takes voxels reference directly (avoids repeated getVoxels() calls)
-    static inline uint8_t getVoxelTypeDirect(const std::vector<Voxel>& voxels, int x, int y, int z) {
-        if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE) {
-            return 0;
-        }
-        return voxels[x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE].getType();
+    // The mesher reads a padded view: the chunk's decoded voxel types plus a
+    // one-voxel border taken from the neighbours (18^3 bytes, stays in L1)
+    static const int PADDED_SIZE = CHUNK_SIZE + 2;
+    static const int PADDED_VOLUME = PADDED_SIZE * PADDED_SIZE * PADDED_SIZE;
+    
+    static void buildPaddedView(const PaletteStorage& voxels, const ChunkBorders* borders,
+                                uint8_t* padded);
+    
+    // Read the padded view at chunk-local coordinates in -1..CHUNK_SIZE.
+    // No bounds checks: only one coordinate may be outside the chunk.
+    static inline uint8_t getVoxelTypeDirect(const uint8_t* padded, int x, int y, int z) {
+        return padded[(x + 1) + (y + 1) * PADDED_SIZE + (z + 1) * PADDED_SIZE * PADDED_SIZE];
     }
     
-    // Greedy meshing implementation for each axis
-    static void greedyMeshAxis(const Chunk& chunk,
-                               std::vector<Vertex>& vertices,
-                               std::vector<uint32_t>& indices,
-                               int axis,
-                               int chunkOffsetX, int chunkOffsetY, int chunkOffsetZ);
+    // Greedy meshing implementation for each axis; quads facing the negative
+    // and positive axis direction go to separate lists
+    static void greedyMeshAxis(const uint8_t* padded,
+                               std::vector<Vertex>& backVertices,
+                               std::vector<Vertex>& frontVertices,
+                               int axis);
+    
+    // Binary mesher: per-axis column bitmasks of solid voxels, from which
+    // each face direction's visible faces are sorted into per-plane,
+    // per-voxel-type row masks (bit u of row v), then merged with bit scans
+    static void generateMeshBinary(const PaletteStorage& voxels,
+                                   const ChunkBorders* borders,
+                                   std::vector<Vertex>& vertices,
+                                   MeshFaceRanges& faceRanges,
+                                   bool templatedEmission);
+    
+    // Greedy-merge the row masks of one plane of faces in direction Face
+    // (typeCount masks per row, consumed in the process) in the reference
+    // mesher's scan order. Quads are written from `out` on, which must have
+    // room for one quad per remaining face; returns the end of the output.
+    template <int Face>
+    static Vertex* greedyMeshPlaneBits(uint64_t* rows, int typeCount, const uint8_t* typeIds,
+                                       int plane, Vertex* out);
+    
+    // Same merge, appending each quad with addQuad (MESH_ALGORITHM_BINARY_ADDQUAD)
+    static void greedyMeshPlaneBitsAddQuad(uint64_t* rows, int typeCount, const uint8_t* typeIds,
+                                           std::vector<Vertex>& vertices,
+                                           int axis, int plane, bool backFace);
+    
+    // Write the four vertices of a quad facing direction Face to `out`,
+    // with the same corners and winding as addQuad. No capacity checks.
+    template <int Face>
+    static void emitQuad(Vertex* out, int x, int y, int z, int width, int height,
+                         uint8_t voxelType);
     
     // Add a merged quad to the mesh
     static void addQuad(std::vector<Vertex>& vertices,
-                       std::vector<uint32_t>& indices,
                        int x, int y, int z,
                        int width, int height,
                        int axis, bool backFace,
-                       int chunkOffsetX, int chunkOffsetY, int chunkOffsetZ);
+                       uint8_t voxelType);
 };
 
 #endif // MESH_GENERATOR_H
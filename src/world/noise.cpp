@@ -1,15 +1,19 @@
 #include "noise.h"
+#include "noise_simd.h"
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <vector>
+
+#if defined(_MSC_VER) && defined(NOISE_USE_AVX2)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
 
 PerlinNoise::PerlinNoise() : PerlinNoise(0) {
 }
 
-PerlinNoise::PerlinNoise(unsigned int seed) {
-    // Initialize permutation table
-    permutation.resize(512);
-    
+PerlinNoise::PerlinNoise(unsigned int seed) : kernel(getBestKernel()) {
     // Fill with values 0-255
     std::vector<int> p(256);
     for (int i = 0; i < 256; i++) {
@@ -22,9 +26,10 @@ PerlinNoise::PerlinNoise(unsigned int seed) {
     
     // Duplicate the permutation vector
     for (int i = 0; i < 256; i++) {
-        permutation[i] = p[i];
-        permutation[256 + i] = p[i];
+        permutation[i] = static_cast<uint8_t>(p[i]);
+        permutation[256 + i] = static_cast<uint8_t>(p[i]);
     }
+    permutation[512] = permutation[513] = permutation[514] = 0;
 }
 
 float PerlinNoise::fade(float t) const {
@@ -44,6 +49,14 @@ float PerlinNoise::grad(int hash, float x, float y, float z) const {
     return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
 }
 
+float PerlinNoise::grad(int hash, float x, float y) const {
+    // The 3D gradients with z = 0
+    int h = hash & 15;
+    float u = h < 8 ? x : y;
+    float v = h < 4 ? y : h == 12 || h == 14 ? x : 0.0f;
+    return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+}
+
 float PerlinNoise::noise(float x, float y, float z) const {
     // Find unit cube that contains point
     int X = static_cast<int>(std::floor(x)) & 255;
@@ -85,8 +98,26 @@ float PerlinNoise::noise(float x, float y, float z) const {
 }
 
 float PerlinNoise::noise(float x, float y) const {
-    // 2D noise is just 3D noise with z = 0
-    return noise(x, y, 0.0f);
+    // noise(x, y, 0) with the z = 0 face only: its fade weight along z is 0,
+    // so the other 4 corners never contribute. Results match the 3D version
+    // bit for bit, except that an exact zero may come out as -0.
+    int X = static_cast<int>(std::floor(x)) & 255;
+    int Y = static_cast<int>(std::floor(y)) & 255;
+    
+    x -= std::floor(x);
+    y -= std::floor(y);
+    
+    float u = fade(x);
+    float v = fade(y);
+    
+    int A = permutation[X] + Y;
+    int B = permutation[X + 1] + Y;
+    
+    return lerp(v,
+        lerp(u, grad(permutation[permutation[A]], x, y),
+                grad(permutation[permutation[B]], x - 1, y)),
+        lerp(u, grad(permutation[permutation[A + 1]], x, y - 1),
+                grad(permutation[permutation[B + 1]], x - 1, y - 1)));
 }
 
 float PerlinNoise::octaveNoise(float x, float y, int octaves, float persistence) const {
@@ -106,3 +137,62 @@ float PerlinNoise::octaveNoise(float x, float y, int octaves, float persistence)
     // Normalize to [-1, 1]
     return total / maxValue;
 }
+
+void PerlinNoise::octaveNoiseGrid(int originX, int originY, int width, int height, float scale,
+                                  int octaves, float persistence, float* out) const {
+    for (int j = 0; j < height; ++j) {
+        const float y = static_cast<float>(originY + j) * scale;
+        float* row = out + static_cast<size_t>(j) * width;
+        
+        int i = 0;
+#ifdef NOISE_USE_AVX2
+        if (kernel == NOISE_KERNEL_AVX2) {
+            i = NoiseSimd::octaveRowAVX2(permutation, originX, y, width, scale, octaves, persistence, row);
+        }
+#endif
+#ifdef NOISE_USE_SSE
+        if (kernel != NOISE_KERNEL_SCALAR) {
+            i += NoiseSimd::octaveRowSSE(permutation, originX + i, y, width - i, scale, octaves, persistence, row + i);
+        }
+#endif
+        
+        // Remaining points (or all of them for the reference kernel)
+        for (; i < width; ++i) {
+            row[i] = octaveNoise(static_cast<float>(originX + i) * scale, y, octaves, persistence);
+        }
+    }
+}
+
+void PerlinNoise::setKernel(NoiseKernel requested) {
+    kernel = std::min(requested, getBestKernel());
+}
+
+NoiseKernel PerlinNoise::getBestKernel() {
+#if defined(NOISE_USE_AVX2) && defined(__GNUC__)
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+#elif defined(NOISE_USE_AVX2) && defined(_MSC_VER)
+    // AVX2 needs CPUID leaf 7 support and the OS saving YMM state
+    static const bool hasAVX2 = []() {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        __cpuid(info, 1);
+        const bool osSavesYmm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) &&
+                                (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        return osSavesYmm && (info[1] & (1 << 5)) != 0;
+    }();
+#else
+    static const bool hasAVX2 = false;
+#endif
+    if (hasAVX2) {
+        return NOISE_KERNEL_AVX2;
+    }
+#ifdef NOISE_USE_SSE
+    return NOISE_KERNEL_SSE2;
+#else
+    return NOISE_KERNEL_SCALAR;
+#endif
+}
@@ -1,7 +1,15 @@
 #ifndef NOISE_H
 #define NOISE_H
 
-#include <vector>
+#include <cstdint>
+
+// Implementations of PerlinNoise::octaveNoiseGrid. All kernels produce
+// bit-identical results; SCALAR is the reference (octaveNoise() per point).
+enum NoiseKernel {
+    NOISE_KERNEL_SCALAR = 0,
+    NOISE_KERNEL_SSE2 = 1,  // 4 points at a time
+    NOISE_KERNEL_AVX2 = 2   // 8 points at a time, gathers from the permutation table
+};
 
 class PerlinNoise {
 public:
@@ -20,13 +28,31 @@ public:
     // octaves: number of noise layers to combine
     // persistence: amplitude multiplier for each octave (typically 0.5)
     float octaveNoise(float x, float y, int octaves, float persistence) const;
+    
+    // Octave noise over a width x height lattice: out[i + j * width] is
+    // octaveNoise((originX + i) * scale, (originY + j) * scale, ...), with
+    // the coordinates computed exactly as written (int to float, then scale)
+    void octaveNoiseGrid(int originX, int originY, int width, int height, float scale,
+                         int octaves, float persistence, float* out) const;
+    
+    // Kernel used by octaveNoiseGrid(). Defaults to getBestKernel(); kernels
+    // the CPU does not support fall back to the best one that it does.
+    void setKernel(NoiseKernel kernel);
+    NoiseKernel getKernel() const { return kernel; }
+    
+    // Fastest kernel supported by this build and CPU (detected at runtime)
+    static NoiseKernel getBestKernel();
 
 private:
-    std::vector<int> permutation;
+    // Shuffled 0-255 twice over, so corner hashes index it without wrapping.
+    // Three bytes of padding keep 32-bit gathers at index 511 in bounds.
+    uint8_t permutation[512 + 3];
+    NoiseKernel kernel;
     
     float fade(float t) const;
     float lerp(float t, float a, float b) const;
     float grad(int hash, float x, float y, float z) const;
+    float grad(int hash, float x, float y) const;
 };
 
 #endif // NOISE_H
@@ -0,0 +1,196 @@
+#include "noise_simd.h"
+
+#ifdef NOISE_USE_SSE
+#include <emmintrin.h>
+#endif
+#ifdef NOISE_USE_AVX2
+#include <immintrin.h>
+#endif
+
+#ifdef NOISE_USE_SSE
+// SSE2 versions of fade(), lerp() and grad(), with the operations in the
+// same order as the scalar code so every lane rounds identically
+static inline __m128 fadeSSE(__m128 t) {
+    __m128 inner = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))),
+                              _mm_set1_ps(10.0f));
+    return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), inner);
+}
+
+static inline __m128 lerpSSE(__m128 t, __m128 a, __m128 b) {
+    return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+static inline __m128 selectSSE(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 gradSSE(__m128i hash, __m128 x, __m128 y) {
+    const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+    const __m128 below8 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+    const __m128 below4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+    const __m128 is12or14 = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)),
+                                                          _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+    const __m128 u = selectSSE(below8, x, y);
+    const __m128 v = selectSSE(below4, y, _mm_and_ps(is12or14, x));
+
+    // Bits 0 and 1 of the hash flip the signs of u and v
+    const __m128 signU = _mm_castsi128_ps(_mm_slli_epi32(h, 31));
+    const __m128 signV = _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(h, 1), 31));
+    return _mm_add_ps(_mm_xor_ps(u, signU), _mm_xor_ps(v, signV));
+}
+
+// Exact floor (including -0.0) for |x| < 2^31
+static inline __m128 floorSSE(__m128 x) {
+    __m128 f = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    f = _mm_sub_ps(f, _mm_and_ps(_mm_cmpgt_ps(f, x), _mm_set1_ps(1.0f)));
+    return _mm_or_ps(f, _mm_and_ps(x, _mm_set1_ps(-0.0f)));
+}
+
+static __m128 noiseSSE(const uint8_t* perm, __m128 x, __m128 y) {
+    const __m128 floorX = floorSSE(x);
+    const __m128 floorY = floorSSE(y);
+    const __m128i mask = _mm_set1_epi32(255);
+    alignas(16) int32_t cellX[4], cellY[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(cellX), _mm_and_si128(_mm_cvttps_epi32(floorX), mask));
+    _mm_store_si128(reinterpret_cast<__m128i*>(cellY), _mm_and_si128(_mm_cvttps_epi32(floorY), mask));
+
+    // SSE2 has no gather; hash each lane's corners with scalar loads
+    alignas(16) int32_t h00[4], h10[4], h01[4], h11[4];
+    for (int lane = 0; lane < 4; ++lane) {
+        const int A = perm[cellX[lane]] + cellY[lane];
+        const int B = perm[cellX[lane] + 1] + cellY[lane];
+        h00[lane] = perm[perm[A]];
+        h10[lane] = perm[perm[B]];
+        h01[lane] = perm[perm[A + 1]];
+        h11[lane] = perm[perm[B + 1]];
+    }
+
+    x = _mm_sub_ps(x, floorX);
+    y = _mm_sub_ps(y, floorY);
+    const __m128 u = fadeSSE(x);
+    const __m128 v = fadeSSE(y);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 x1 = _mm_sub_ps(x, one);
+    const __m128 y1 = _mm_sub_ps(y, one);
+
+    return lerpSSE(v,
+        lerpSSE(u, gradSSE(_mm_load_si128(reinterpret_cast<const __m128i*>(h00)), x, y),
+                   gradSSE(_mm_load_si128(reinterpret_cast<const __m128i*>(h10)), x1, y)),
+        lerpSSE(u, gradSSE(_mm_load_si128(reinterpret_cast<const __m128i*>(h01)), x, y1),
+                   gradSSE(_mm_load_si128(reinterpret_cast<const __m128i*>(h11)), x1, y1)));
+}
+
+// Fills lanes [0, width & ~3) of one grid row; returns how many were filled
+int NoiseSimd::octaveRowSSE(const uint8_t* perm, int originX, float y, int width, float scale,
+                            int octaves, float persistence, float* out) {
+    int i = 0;
+    for (; i + 4 <= width; i += 4) {
+        const __m128i column = _mm_add_epi32(_mm_set1_epi32(originX + i), _mm_set_epi32(3, 2, 1, 0));
+        const __m128 x = _mm_mul_ps(_mm_cvtepi32_ps(column), _mm_set1_ps(scale));
+        const __m128 yv = _mm_set1_ps(y);
+
+        __m128 total = _mm_setzero_ps();
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+        float maxValue = 0.0f;
+        for (int octave = 0; octave < octaves; ++octave) {
+            const __m128 f = _mm_set1_ps(frequency);
+            const __m128 n = noiseSSE(perm, _mm_mul_ps(x, f), _mm_mul_ps(yv, f));
+            total = _mm_add_ps(total, _mm_mul_ps(n, _mm_set1_ps(amplitude)));
+
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0f;
+        }
+        _mm_storeu_ps(out + i, _mm_div_ps(total, _mm_set1_ps(maxValue)));
+    }
+    return i;
+}
+#endif
+
+#ifdef NOISE_USE_AVX2
+NOISE_TARGET_AVX2 static inline __m256 fadeAVX2(__m256 t) {
+    __m256 inner = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)),
+                                                                _mm256_set1_ps(15.0f))),
+                                 _mm256_set1_ps(10.0f));
+    return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), inner);
+}
+
+NOISE_TARGET_AVX2 static inline __m256 lerpAVX2(__m256 t, __m256 a, __m256 b) {
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+NOISE_TARGET_AVX2 static inline __m256 gradAVX2(__m256i hash, __m256 x, __m256 y) {
+    const __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+    const __m256 below8 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), h));
+    const __m256 below4 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+    const __m256 is12or14 = _mm256_castsi256_ps(_mm256_or_si256(_mm256_cmpeq_epi32(h, _mm256_set1_epi32(12)),
+                                                                _mm256_cmpeq_epi32(h, _mm256_set1_epi32(14))));
+    const __m256 u = _mm256_blendv_ps(y, x, below8);
+    const __m256 v = _mm256_blendv_ps(_mm256_and_ps(is12or14, x), y, below4);
+
+    const __m256 signU = _mm256_castsi256_ps(_mm256_slli_epi32(h, 31));
+    const __m256 signV = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_srli_epi32(h, 1), 31));
+    return _mm256_add_ps(_mm256_xor_ps(u, signU), _mm256_xor_ps(v, signV));
+}
+
+// Byte lookups as 32-bit gathers; the table's padding covers the overread
+NOISE_TARGET_AVX2 static inline __m256i lookupAVX2(const uint8_t* perm, __m256i index) {
+    return _mm256_and_si256(_mm256_i32gather_epi32(reinterpret_cast<const int*>(perm), index, 1),
+                            _mm256_set1_epi32(255));
+}
+
+NOISE_TARGET_AVX2 static __m256 noiseAVX2(const uint8_t* perm, __m256 x, __m256 y) {
+    const __m256 floorX = _mm256_floor_ps(x);
+    const __m256 floorY = _mm256_floor_ps(y);
+    const __m256i mask = _mm256_set1_epi32(255);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i cellX = _mm256_and_si256(_mm256_cvttps_epi32(floorX), mask);
+    const __m256i cellY = _mm256_and_si256(_mm256_cvttps_epi32(floorY), mask);
+
+    const __m256i A = _mm256_add_epi32(lookupAVX2(perm, cellX), cellY);
+    const __m256i B = _mm256_add_epi32(lookupAVX2(perm, _mm256_add_epi32(cellX, one)), cellY);
+    const __m256i h00 = lookupAVX2(perm, lookupAVX2(perm, A));
+    const __m256i h10 = lookupAVX2(perm, lookupAVX2(perm, B));
+    const __m256i h01 = lookupAVX2(perm, lookupAVX2(perm, _mm256_add_epi32(A, one)));
+    const __m256i h11 = lookupAVX2(perm, lookupAVX2(perm, _mm256_add_epi32(B, one)));
+
+    x = _mm256_sub_ps(x, floorX);
+    y = _mm256_sub_ps(y, floorY);
+    const __m256 u = fadeAVX2(x);
+    const __m256 v = fadeAVX2(y);
+    const __m256 x1 = _mm256_sub_ps(x, _mm256_set1_ps(1.0f));
+    const __m256 y1 = _mm256_sub_ps(y, _mm256_set1_ps(1.0f));
+
+    return lerpAVX2(v,
+        lerpAVX2(u, gradAVX2(h00, x, y), gradAVX2(h10, x1, y)),
+        lerpAVX2(u, gradAVX2(h01, x, y1), gradAVX2(h11, x1, y1)));
+}
+
+NOISE_TARGET_AVX2 int NoiseSimd::octaveRowAVX2(const uint8_t* perm, int originX, float y, int width, float scale,
+                                               int octaves, float persistence, float* out) {
+    int i = 0;
+    for (; i + 8 <= width; i += 8) {
+        const __m256i column = _mm256_add_epi32(_mm256_set1_epi32(originX + i),
+                                                _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        const __m256 x = _mm256_mul_ps(_mm256_cvtepi32_ps(column), _mm256_set1_ps(scale));
+        const __m256 yv = _mm256_set1_ps(y);
+
+        __m256 total = _mm256_setzero_ps();
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+        float maxValue = 0.0f;
+        for (int octave = 0; octave < octaves; ++octave) {
+            const __m256 f = _mm256_set1_ps(frequency);
+            const __m256 n = noiseAVX2(perm, _mm256_mul_ps(x, f), _mm256_mul_ps(yv, f));
+            total = _mm256_add_ps(total, _mm256_mul_ps(n, _mm256_set1_ps(amplitude)));
+
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0f;
+        }
+        _mm256_storeu_ps(out + i, _mm256_div_ps(total, _mm256_set1_ps(maxValue)));
+    }
+    return i;
+}
+#endif
@@ -0,0 +1,40 @@
+#ifndef NOISE_SIMD_H
+#define NOISE_SIMD_H
+
+#include <cstdint>
+
+// SIMD row kernels behind PerlinNoise::octaveNoiseGrid (internal to
+// noise.cpp and noise_simd.cpp)
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NOISE_USE_SSE 1
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define NOISE_USE_AVX2 1
+#endif
+#endif
+
+// AVX2 code is compiled for that target only, so the rest of the binary
+// still runs on any x86-64 CPU. FMA is deliberately not enabled: fused
+// multiply-adds would round differently from the scalar reference.
+#if defined(__GNUC__)
+#define NOISE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NOISE_TARGET_AVX2
+#endif
+
+namespace NoiseSimd {
+    // Octave noise for points (originX + i) * scale, y of one grid row, with
+    // `perm` the noise's padded permutation table. Each fills lanes
+    // [0, width rounded down to its vector width) and returns how many it
+    // filled; the caller finishes the row.
+#ifdef NOISE_USE_SSE
+    int octaveRowSSE(const uint8_t* perm, int originX, float y, int width, float scale,
+                     int octaves, float persistence, float* out);
+#endif
+#ifdef NOISE_USE_AVX2
+    NOISE_TARGET_AVX2 int octaveRowAVX2(const uint8_t* perm, int originX, float y, int width, float scale,
+                                        int octaves, float persistence, float* out);
+#endif
+}
+
+#endif // NOISE_SIMD_H
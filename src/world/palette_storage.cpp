@@ -0,0 +1,101 @@
+#include "palette_storage.h"
+#include <algorithm>
+#include <cstring>
+
+PaletteStorage::PaletteStorage(int voxelCount)
+    : voxelCount(voxelCount), bitsLog2(0), indexMask(1) {
+    clear();
+}
+
+void PaletteStorage::set(int index, uint8_t type) {
+    if (words.empty()) {
+        if (type == palette[0]) {
+            return;
+        }
+        // First differing voxel: materialise a 1-bit index array (all entries
+        // pointing at the existing uniform type)
+        bitsLog2 = 0;
+        indexMask = 1;
+        words.assign(static_cast<size_t>(voxelCount) >> 6, 0);
+    }
+
+    const uint64_t paletteIndex = static_cast<uint64_t>(findOrAddPaletteEntry(type));
+
+    uint64_t& word = words[index >> (6 - bitsLog2)];
+    const int shift = (index & ((64 >> bitsLog2) - 1)) << bitsLog2;
+    word = (word & ~(indexMask << shift)) | (paletteIndex << shift);
+}
+
+void PaletteStorage::fill(uint8_t type) {
+    bitsLog2 = 0;
+    indexMask = 1;
+    palette.assign(1, type);
+    std::vector<uint64_t>().swap(words);
+}
+
+void PaletteStorage::clear() {
+    bitsLog2 = 0;
+    indexMask = 1;
+    palette.assign(1, VoxelType::AIR);
+    words.clear();
+}
+
+void PaletteStorage::unpack(uint8_t* out) const {
+    if (words.empty()) {
+        std::memset(out, palette[0], static_cast<size_t>(voxelCount));
+        return;
+    }
+
+    const int bits = 1 << bitsLog2;
+    const int perWord = 64 >> bitsLog2;
+
+    // Decode word by word; the inner loop has no divisions or bounds checks
+    for (size_t w = 0; w < words.size(); ++w) {
+        uint64_t word = words[w];
+        for (int i = 0; i < perWord; ++i) {
+            *out++ = palette[word & indexMask];
+            word >>= bits;
+        }
+    }
+}
+
+size_t PaletteStorage::getMemoryUsage() const {
+    return sizeof(*this) + palette.capacity() + words.capacity() * sizeof(uint64_t);
+}
+
+int PaletteStorage::findOrAddPaletteEntry(uint8_t type) {
+    auto it = std::find(palette.begin(), palette.end(), type);
+    if (it != palette.end()) {
+        return static_cast<int>(it - palette.begin());
+    }
+
+    palette.push_back(type);
+    const int paletteIndex = static_cast<int>(palette.size()) - 1;
+
+    // Widen the index width once the palette outgrows it (1 -> 2 -> 4 -> 8 bits)
+    if (paletteIndex > static_cast<int>(indexMask)) {
+        widen(bitsLog2 + 1);
+    }
+    return paletteIndex;
+}
+
+void PaletteStorage::widen(int newBitsLog2) {
+    const int oldBitsLog2 = bitsLog2;
+    const uint64_t oldMask = indexMask;
+
+    bitsLog2 = newBitsLog2;
+    indexMask = (uint64_t(1) << (1 << bitsLog2)) - 1;
+    words.resize(static_cast<size_t>(voxelCount) >> (6 - bitsLog2), 0);
+
+    // Re-pack every index at the new width, in place. Walking from the last
+    // index down is safe: an index's new bit position is at or beyond its old
+    // one, so it only overwrites indices that have already been moved.
+    for (int index = voxelCount - 1; index >= 0; --index) {
+        const int oldShift = (index & ((64 >> oldBitsLog2) - 1)) << oldBitsLog2;
+        const uint64_t value = (words[index >> (6 - oldBitsLog2)] >> oldShift) & oldMask;
+
+        uint64_t& word = words[index >> (6 - bitsLog2)];
+        const int shift = (index & ((64 >> bitsLog2) - 1)) << bitsLog2;
+        word = (word & ~(indexMask << shift)) | (value << shift);
+    }
+}
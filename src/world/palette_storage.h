@@ -0,0 +1,73 @@
+#ifndef PALETTE_STORAGE_H
+#define PALETTE_STORAGE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "voxel.h"
+
+// Palette-compressed voxel storage
+//
+// Each voxel stores an index into a small per-chunk palette of block IDs
+// instead of the block ID itself. Indices are bit-packed into 64-bit words at
+// 1, 2, 4 or 8 bits per voxel and the storage widens automatically when a new
+// block ID no longer fits. Since 64 is a multiple of every supported width, an
+// index never straddles two words.
+//
+// Typical terrain chunks use 4 block types, i.e. 2 bits per voxel:
+// a 16^3 chunk takes 1 KiB of index data instead of 64 KiB of Voxel objects.
+//
+// A storage whose voxels all share one block ID is "uniform": it keeps only
+// the single palette entry and no index array at all. New storage starts out
+// as uniform air and allocates its index array on the first differing set().
+//
+// Palette entries are never removed, so a chunk that once held many block
+// types keeps its wider index width until it is cleared. Widening repacks
+// the index array in place.
+class PaletteStorage {
+public:
+    explicit PaletteStorage(int voxelCount);
+
+    // Block ID at a linear voxel index
+    inline uint8_t get(int index) const {
+        if (words.empty()) {
+            return palette[0];
+        }
+        const uint64_t word = words[index >> (6 - bitsLog2)];
+        const int shift = (index & ((64 >> bitsLog2) - 1)) << bitsLog2;
+        return palette[(word >> shift) & indexMask];
+    }
+
+    void set(int index, uint8_t type);
+
+    // Set every voxel to one block ID, releasing the index array
+    void fill(uint8_t type);
+
+    // Reset every voxel to air and drop all palette entries. Unlike fill(),
+    // the index array's memory is kept, so recycled chunks do not reallocate.
+    void clear();
+
+    bool isUniform() const { return words.empty(); }
+    uint8_t getUniformType() const { return palette[0]; }
+
+    // Decode all voxels into a flat byte array of getVoxelCount() entries.
+    // Hot loops (meshing) should decode once and read the flat array.
+    void unpack(uint8_t* out) const;
+
+    int getVoxelCount() const { return voxelCount; }
+    int getBitsPerIndex() const { return words.empty() ? 0 : (1 << bitsLog2); }
+    size_t getPaletteSize() const { return palette.size(); }
+    size_t getMemoryUsage() const;
+
+private:
+    int voxelCount;
+    int bitsLog2;          // log2 of bits per index: 0..3 for 1/2/4/8 bits
+    uint64_t indexMask;
+    std::vector<uint8_t> palette;
+    std::vector<uint64_t> words;
+
+    int findOrAddPaletteEntry(uint8_t type);
+    void widen(int newBitsLog2);
+};
+
+#endif // PALETTE_STORAGE_H
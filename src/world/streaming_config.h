@@ -0,0 +1,43 @@
+#ifndef STREAMING_CONFIG_H
+#define STREAMING_CONFIG_H
+
+// Per-frame budgets for chunk streaming, so that a burst of new chunks is
+// spread over several frames (nearest first) instead of stalling one.
+// A budget of 0 means unlimited.
+struct StreamingConfig {
+    // Streaming window radii in chunks: a cylinder that reaches far
+    // horizontally but only a few chunks up and down, since the terrain
+    // band itself is only four chunks tall
+    int horizontalDistance;
+    int verticalDistance;
+    
+    // Generation jobs handed to the workers per frame
+    unsigned int generationJobsPerFrame;
+    
+    // Generation jobs queued or running at once (0 = twice the worker
+    // count). Keeping this small leaves requests in the priority queue, where
+    // they can still be reordered as the camera moves.
+    unsigned int maxGenerationJobsInFlight;
+    
+    // Mesh jobs submitted and finished meshes uploaded per frame
+    unsigned int meshJobsPerFrame;
+    unsigned int uploadsPerFrame;
+    
+    // Main-thread time the renderer may spend per frame submitting mesh jobs
+    // and uploading meshes, in milliseconds
+    float meshTimeBudgetMs;
+    
+    // Never load chunk layers that the terrain height bounds prove to be all
+    // air or all stone (most of the load sphere); the chunk manager reports
+    // their contents analytically instead
+    bool skipUniformLayers;
+    
+    StreamingConfig()
+        : horizontalDistance(20), verticalDistance(4),
+          generationJobsPerFrame(32), maxGenerationJobsInFlight(0),
+          meshJobsPerFrame(64), uploadsPerFrame(64), meshTimeBudgetMs(4.0f),
+          skipUniformLayers(true) {
+    }
+};
+
+#endif // STREAMING_CONFIG_H
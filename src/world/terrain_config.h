@@ -12,6 +12,11 @@ namespace TerrainConfig {
     constexpr float PERSISTENCE = 0.5f;         // Amplitude decay for each octave
     constexpr float HEIGHT_MULTIPLIER = 20.0f;  // Maximum terrain height variation
     constexpr int BASE_HEIGHT = 32;             // Base terrain level
+    constexpr int SOIL_DEPTH = 4;               // Grass + dirt layers above stone
+    
+    // Surface height bounds: octave noise is normalised to [-1, 1]
+    constexpr int MIN_HEIGHT = BASE_HEIGHT - static_cast<int>(HEIGHT_MULTIPLIER);
+    constexpr int MAX_HEIGHT = BASE_HEIGHT + static_cast<int>(HEIGHT_MULTIPLIER);
 }
 
 #endif // TERRAIN_CONFIG_H
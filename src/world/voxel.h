@@ -1,21 +1,16 @@
 #ifndef VOXEL_H
 #define VOXEL_H
 
-class Voxel {
-public:
-    Voxel();
-    Voxel(int x, int y, int z, int type);
-    
-    int getPositionX() const;
-    int getPositionY() const;
-    int getPositionZ() const;
-    int getType() const;
+#include <cstdint>
 
-private:
-    int positionX;
-    int positionY;
-    int positionZ;
-    int voxelType;
-};
+// Block type IDs stored in chunk voxel storage.
+// A voxel's position is implied by its index in the chunk, so only the
+// type is stored (see PaletteStorage).
+namespace VoxelType {
+    constexpr uint8_t AIR = 0;
+    constexpr uint8_t GRASS = 1;   // Top layer
+    constexpr uint8_t DIRT = 2;    // Layers just below the surface
+    constexpr uint8_t STONE = 3;   // Everything deeper
+}
 
-#endif // VOXEL_H
\ No newline at end of file
+#endif // VOXEL_H